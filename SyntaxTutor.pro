@@ -8,12 +8,20 @@ CONFIG += c++20
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    backend/compressed_table.cpp \
     backend/grammar.cpp \
+    backend/grammar_analysis.cpp \
     backend/grammar_factory.cpp \
+    backend/lalr1_parser.cpp \
     backend/ll1_parser.cpp \
     backend/lr0_item.cpp \
+    backend/lr1_parser.cpp \
+    backend/parser_emitter.cpp \
+    backend/parser_image.cpp \
     backend/slr1_parser.cpp \
+    backend/slr1_recognizer.cpp \
     backend/symbol_table.cpp \
+    backend/symbol_trie.cpp \
     customtextedit.cpp \
     lltabledialog.cpp \
     lltutorwindow.cpp \
@@ -25,14 +33,27 @@ SOURCES += \
 
 HEADERS += \
     UniqueQueue.h \
+    backend/batch_parse.hpp \
+    backend/bitset.hpp \
+    backend/compressed_table.hpp \
+    backend/digraph.hpp \
     backend/grammar.hpp \
+    backend/grammar_analysis.hpp \
     backend/grammar_factory.hpp \
+    backend/lalr1_parser.hpp \
     backend/ll1_parser.hpp \
     backend/lr0_item.hpp \
+    backend/lr1_parser.hpp \
+    backend/parser_emitter.hpp \
+    backend/parser_image.hpp \
     backend/slr1_parser.hpp \
+    backend/slr1_recognizer.hpp \
     backend/state.hpp \
+    backend/static_grammar.hpp \
     backend/symbol_table.hpp \
+    backend/symbol_trie.hpp \
     backend/tabulate.hpp \
+    backend/terminal_set.hpp \
     customtextedit.h \
     lltabledialog.h \
     lltutorwindow.h \
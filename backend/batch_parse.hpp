@@ -0,0 +1,68 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "symbol_table.hpp"
+
+/// @brief Outcome of one input of ParseBatch.
+struct BatchResult {
+    bool        accepted;
+    std::size_t error_position;
+};
+
+/**
+ * @brief Recognizes many inputs with the same compiled tables, spread over
+ * several threads.
+ *
+ * The inputs are split in contiguous blocks, one per thread. Every thread
+ * makes its own ParseStacks once and reuses them for its whole block, and
+ * writes only the results of its block, so the threads share nothing but
+ * the parser, which Parse does not modify.
+ *
+ * @tparam Parser A parser with a const `Parse(tokens, stacks)` and
+ * `MakeParseStacks()`: SLR1Parser, LALR1Parser, LR1Parser or LL1Parser,
+ * with its tables already built.
+ * @param parser Parser whose tables are used.
+ * @param inputs Token sequences, as taken by Parser::Parse.
+ * @param threads Number of threads, the hardware concurrency if 0.
+ * @return One result per input, in input order.
+ */
+template <typename Parser>
+std::vector<BatchResult>
+ParseBatch(const Parser& parser, std::span<const std::vector<SymbolId>> inputs,
+           unsigned int threads = 0) {
+    std::vector<BatchResult> results(inputs.size());
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t blocks = std::min<std::size_t>(threads, inputs.size());
+    if (blocks == 0) {
+        return results;
+    }
+    std::size_t block = (inputs.size() + blocks - 1) / blocks;
+
+    auto parse_block = [&](std::size_t begin) {
+        const std::size_t end = std::min(begin + block, inputs.size());
+
+        typename Parser::ParseStacks stacks = parser.MakeParseStacks();
+        for (std::size_t i = begin; i < end; ++i) {
+            auto result = parser.Parse(inputs[i], stacks);
+            results[i]  = {result.accepted, result.error_position};
+        }
+    };
+
+    // The calling thread takes the first block
+    std::vector<std::thread> workers;
+    workers.reserve(blocks - 1);
+    for (std::size_t begin = block; begin < inputs.size(); begin += block) {
+        workers.emplace_back(parse_block, begin);
+    }
+    parse_block(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return results;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Fixed-size set of small integers stored as a bitset.
+ *
+ * Union, equality and emptiness work a whole word at a time; union uses SSE2
+ * when it is available.
+ */
+class BitSet {
+  public:
+    BitSet() = default;
+
+    /**
+     * @brief Creates an empty set able to hold indices below size.
+     */
+    explicit BitSet(std::size_t size) : words_((size + 63) / 64, 0) {}
+
+    void Insert(std::uint32_t index) {
+        words_[index / 64] |= std::uint64_t{1} << (index % 64);
+    }
+
+    void Erase(std::uint32_t index) {
+        words_[index / 64] &= ~(std::uint64_t{1} << (index % 64));
+    }
+
+    bool Contains(std::uint32_t index) const {
+        return (words_[index / 64] >> (index % 64)) & 1;
+    }
+
+    void Clear() { std::fill(words_.begin(), words_.end(), 0); }
+
+    /**
+     * @brief Adds every element of other to this set. Both sets must have been
+     * created with the same size.
+     *
+     * @return true if the set gained at least one element.
+     */
+    bool Merge(const BitSet& other) {
+        std::uint64_t*       dst     = words_.data();
+        const std::uint64_t* src     = other.words_.data();
+        std::size_t          n       = words_.size();
+        std::size_t          i       = 0;
+        std::uint64_t        changed = 0;
+#if defined(__SSE2__)
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 2 <= n; i += 2) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i u = _mm_or_si128(a, b);
+            acc       = _mm_or_si128(acc, _mm_xor_si128(u, a));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), u);
+        }
+        changed = static_cast<std::uint64_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) !=
+            0xFFFF);
+#endif
+        for (; i < n; ++i) {
+            std::uint64_t u = dst[i] | src[i];
+            changed |= u ^ dst[i];
+            dst[i] = u;
+        }
+        return changed != 0;
+    }
+
+    /// @brief Checks if both sets share at least one element.
+    bool Intersects(const BitSet& other) const {
+        for (std::size_t i = 0; i < words_.size(); ++i) {
+            if ((words_[i] & other.words_[i]) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Empty() const {
+        std::uint64_t any = 0;
+        for (std::uint64_t w : words_) {
+            any |= w;
+        }
+        return any == 0;
+    }
+
+    std::size_t Count() const {
+        std::size_t count = 0;
+        for (std::uint64_t w : words_) {
+            count += static_cast<std::size_t>(std::popcount(w));
+        }
+        return count;
+    }
+
+    bool operator==(const BitSet& other) const = default;
+
+    /**
+     * @brief Calls f with the index of every element, in increasing order.
+     */
+    template <typename F> void ForEach(F&& f) const {
+        for (std::size_t w = 0; w < words_.size(); ++w) {
+            std::uint64_t bits = words_[w];
+            while (bits != 0) {
+                f(static_cast<std::uint32_t>(w * 64 + std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+  private:
+    std::vector<std::uint64_t> words_;
+};
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "compressed_table.hpp"
+#include "slr1_parser.hpp"
+
+CompressedTable::CompressedTable(std::span<const std::uint32_t> dense,
+                                 std::size_t columns, std::uint32_t empty)
+    : rows_(columns == 0 ? 0 : dense.size() / columns), columns_(columns) {
+    // Identical rows share one distinct row
+    std::map<std::vector<std::uint32_t>, std::uint32_t> distinct;
+    std::vector<std::vector<std::uint32_t>>             rows;
+    row_of_.resize(rows_);
+    for (std::size_t row = 0; row < rows_; ++row) {
+        std::vector<std::uint32_t> cells(dense.begin() + row * columns,
+                                         dense.begin() + (row + 1) * columns);
+        auto [it, inserted] = distinct.try_emplace(
+            cells, static_cast<std::uint32_t>(rows.size()));
+        if (inserted) {
+            rows.push_back(std::move(cells));
+        }
+        row_of_[row] = it->second;
+    }
+
+    // Pick the default of every distinct row and list the columns to store
+    std::vector<std::vector<std::uint32_t>> stored(rows.size());
+    default_.assign(rows.size(), empty);
+    for (std::size_t r = 0; r < rows.size(); ++r) {
+        std::unordered_map<std::uint32_t, std::size_t> counts;
+        for (std::uint32_t cell : rows[r]) {
+            ++counts[cell];
+        }
+        std::uint32_t best       = empty;
+        std::size_t   best_count = 0;
+        for (const auto& [value, count] : counts) {
+            if (value != empty &&
+                (count > best_count || (count == best_count && value < best))) {
+                best       = value;
+                best_count = count;
+            }
+        }
+        if (best_count > counts[empty]) {
+            default_[r] = best;
+        }
+        for (std::uint32_t column = 0; column < columns; ++column) {
+            if (rows[r][column] != default_[r]) {
+                stored[r].push_back(column);
+            }
+        }
+    }
+
+    // First fit, placing the fullest rows first
+    std::vector<std::uint32_t> order(rows.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::uint32_t a, std::uint32_t b) {
+                         return stored[a].size() > stored[b].size();
+                     });
+    base_.assign(rows.size(), 0);
+    std::size_t first_free = 0;
+    for (std::uint32_t r : order) {
+        const std::vector<std::uint32_t>& entries = stored[r];
+        if (entries.empty()) {
+            continue;
+        }
+        // The first entry must land on a free slot, so no base below
+        // first_free - entries[0] can work
+        std::size_t base =
+            first_free > entries[0] ? first_free - entries[0] : 0;
+        auto fits = [&](std::size_t b) {
+            return std::all_of(
+                entries.begin(), entries.end(), [&](std::uint32_t column) {
+                    return b + column >= check_.size() ||
+                           check_[b + column] == FREE;
+                });
+        };
+        while (!fits(base)) {
+            ++base;
+        }
+        if (base + columns > check_.size()) {
+            check_.resize(base + columns, FREE);
+            value_.resize(base + columns, empty);
+        }
+        for (std::uint32_t column : entries) {
+            check_[base + column] = r;
+            value_[base + column] = rows[r][column];
+        }
+        base_[r] = static_cast<std::uint32_t>(base);
+        while (first_free < check_.size() && check_[first_free] != FREE) {
+            ++first_free;
+        }
+    }
+
+    // Trailing slots only exist because rows were padded to their width
+    while (!check_.empty() && check_.back() == FREE) {
+        check_.pop_back();
+        value_.pop_back();
+    }
+}
+
+std::size_t CompressedTable::Bytes() const {
+    return (row_of_.size() + base_.size() + default_.size() + check_.size() +
+            value_.size()) *
+           sizeof(std::uint32_t);
+}
+
+CompressedParseTables::CompressedParseTables(const SLR1Parser& parser)
+    : column_(parser.gr_.st_.kind_index_),
+      actions_(parser.dense_actions_, parser.action_columns_,
+               SLR1Parser::EMPTY_ACTION),
+      gotos_(parser.dense_gotos_, parser.goto_columns_, SLR1Parser::NO_STATE) {
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "slr1_parser.hpp"
+#include "symbol_table.hpp"
+
+/**
+ * @class CompressedTable
+ * @brief Read-only copy of a dense row-major table of 32-bit entries, packed
+ * the way yacc packs its parse tables.
+ *
+ * - Identical rows are stored once.
+ * - Each row gets a default entry, its most frequent one, and only the cells
+ *   that differ from it are stored. A default is only used when it removes
+ *   more cells than the empty ones it forces to store, so every lookup still
+ *   returns exactly the dense value.
+ * - The remaining entries of all rows are overlapped in a single array (comb
+ *   or row displacement): row r starts at base_[r] and a slot belongs to it
+ *   when check_ holds r.
+ */
+class CompressedTable {
+  public:
+    CompressedTable() = default;
+
+    /**
+     * @brief Compresses a dense table.
+     *
+     * @param dense The table, row-major, with columns entries per row.
+     * @param columns Number of columns.
+     * @param empty Value of the cells without an entry.
+     */
+    CompressedTable(std::span<const std::uint32_t> dense, std::size_t columns,
+                    std::uint32_t empty);
+
+    /// @brief Entry at (row, column); the same value as in the dense table.
+    std::uint32_t At(std::size_t row, std::size_t column) const {
+        std::uint32_t r    = row_of_[row];
+        std::size_t   slot = base_[r] + column;
+        return slot < check_.size() && check_[slot] == r ? value_[slot]
+                                                          : default_[r];
+    }
+
+    /// @brief Bytes taken by the compressed arrays.
+    std::size_t Bytes() const;
+
+    /// @brief Bytes taken by the dense table it was built from.
+    std::size_t DenseBytes() const {
+        return rows_ * columns_ * sizeof(std::uint32_t);
+    }
+
+    /// @brief Number of distinct rows kept.
+    std::size_t DistinctRows() const { return base_.size(); }
+
+  private:
+    /// @brief Marks a free slot in check_.
+    static constexpr std::uint32_t FREE = static_cast<std::uint32_t>(-1);
+
+    std::size_t rows_{0};
+    std::size_t columns_{0};
+
+    /// @brief Distinct row used by each row of the dense table.
+    std::vector<std::uint32_t> row_of_;
+
+    /// @brief Start of each distinct row in check_ and value_.
+    std::vector<std::uint32_t> base_;
+
+    /// @brief Default entry of each distinct row.
+    std::vector<std::uint32_t> default_;
+
+    /// @brief Distinct row owning each slot, or FREE.
+    std::vector<std::uint32_t> check_;
+
+    /// @brief Entry stored in each slot.
+    std::vector<std::uint32_t> value_;
+};
+
+/**
+ * @class CompressedParseTables
+ * @brief Compressed ACTION and GOTO tables of an SLR(1) parser.
+ *
+ * Built from the dense tables of a parser on which MakeParser succeeded.
+ * Lookups return the same entries as SLR1Parser::ActionAt and
+ * SLR1Parser::GotoAt: an error cell is never turned into a default
+ * reduction.
+ */
+class CompressedParseTables {
+  public:
+    explicit CompressedParseTables(const SLR1Parser& parser);
+
+    /// @brief Packed ACTION entry of a state for a terminal.
+    SLR1Parser::PackedAction Action(unsigned int state,
+                                    SymbolId     terminal) const {
+        return actions_.At(state, column_[terminal]);
+    }
+
+    /// @brief GOTO entry of a state for a non-terminal, or
+    /// SLR1Parser::NO_STATE.
+    std::uint32_t Goto(unsigned int state, SymbolId non_terminal) const {
+        return gotos_.At(state, column_[non_terminal]);
+    }
+
+    /// @brief Bytes taken by both compressed tables.
+    std::size_t CompressedBytes() const {
+        return actions_.Bytes() + gotos_.Bytes() +
+               column_.size() * sizeof(std::uint32_t);
+    }
+
+    /// @brief Bytes taken by the dense tables they were built from.
+    std::size_t UncompressedBytes() const {
+        return actions_.DenseBytes() + gotos_.DenseBytes();
+    }
+
+  private:
+    /// @brief Column of each symbol, its terminal or non-terminal index.
+    std::vector<std::uint32_t> column_;
+    CompressedTable            actions_;
+    CompressedTable            gotos_;
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Solves F(x) = F'(x) ∪ ⋃{ F(y) | x R y } over a relation R, using the
+ * Digraph algorithm of DeRemer and Pennello.
+ *
+ * Every strongly connected component of R is found with a Tarjan-like
+ * traversal and all its nodes end up sharing the same set, so each edge is
+ * followed once. The traversal keeps its own stack instead of recursing,
+ * which keeps deep relations from large grammars off the call stack.
+ *
+ * @tparam Set Set type with a `bool Merge(const Set&)` union.
+ * @param relation Adjacency lists of R, indexed by node.
+ * @param sets On entry F'(x) for every node x; on return F(x).
+ */
+template <typename Set>
+void Digraph(const std::vector<std::vector<std::uint32_t>>& relation,
+             std::vector<Set>&                              sets) {
+    struct Frame {
+        std::uint32_t node;
+        std::size_t   edge;
+        std::size_t   depth;
+    };
+    constexpr std::size_t INFINITE = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::size_t>   n(sets.size(), 0);
+    std::vector<std::uint32_t> stack;
+    std::vector<Frame>         calls;
+
+    auto enter = [&](std::uint32_t x) {
+        stack.push_back(x);
+        n[x] = stack.size();
+        calls.push_back({x, 0, stack.size()});
+    };
+
+    for (std::uint32_t root = 0; root < sets.size(); ++root) {
+        if (n[root] != 0) {
+            continue;
+        }
+        enter(root);
+        while (!calls.empty()) {
+            Frame&        frame = calls.back();
+            std::uint32_t x     = frame.node;
+            if (frame.edge < relation[x].size()) {
+                std::uint32_t y = relation[x][frame.edge++];
+                if (n[y] == 0) {
+                    enter(y);
+                    continue;
+                }
+                n[x] = std::min(n[x], n[y]);
+                sets[x].Merge(sets[y]);
+                continue;
+            }
+
+            // x is the root of a component: every node above it on the stack
+            // belongs to the same one and gets its set
+            if (n[x] == frame.depth) {
+                std::uint32_t top;
+                do {
+                    top = stack.back();
+                    stack.pop_back();
+                    n[top] = INFINITE;
+                    if (top != x) {
+                        sets[top] = sets[x];
+                    }
+                } while (top != x);
+            }
+            calls.pop_back();
+            if (!calls.empty()) {
+                std::uint32_t parent = calls.back().node;
+                n[parent]            = std::min(n[parent], n[x]);
+                sets[parent].Merge(sets[x]);
+            }
+        }
+    }
+}
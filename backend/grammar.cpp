@@ -1,7 +1,10 @@
 #include "grammar.hpp"
+#include "grammar_analysis.hpp"
 #include "symbol_table.hpp"
+#include "symbol_trie.hpp"
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -24,6 +27,7 @@ Grammar::Grammar(
     g_ = grammar;
     g_[axiom_] = {{"A", st_.EOL_}};
     st_.PutSymbol(axiom_, false);
+    BuildProductionStore();
 }
 
 void Grammar::TransformToAugmentedGrammar()
@@ -33,10 +37,12 @@ void Grammar::TransformToAugmentedGrammar()
     st_.PutSymbol(new_axiom, false);
 
     axiom_ = new_axiom;
+    BuildProductionStore();
 }
 
 void Grammar::SetAxiom(const std::string& axiom) {
     axiom_ = axiom;
+    analysis_.reset();
 }
 
 bool Grammar::HasEmptyProduction(const std::string& antecedent) {
@@ -92,39 +98,120 @@ std::string Grammar::GenerateNewNonTerminal(const std::string& base) {
 void Grammar::AddProduction(const std::string&              antecedent,
                             const std::vector<std::string>& consequent) {
     g_[antecedent].push_back(std::move(consequent));
+    BuildProductionStore();
 }
 
-std::vector<std::string> Grammar::Split(const std::string& s) {
-    if (s == st_.EPSILON_) {
-        return {st_.EPSILON_};
+Grammar::SplitResult Grammar::Split(const std::string& s) const {
+    SplitResult result;
+    result.error_position =
+        Symbols()->Split(s, [&](SymbolId id) {
+            result.symbols.push_back(st_.Name(id));
+        });
+    if (result.error_position != std::string::npos) {
+        result.symbols.clear();
     }
-    std::vector<std::string> splitted;
-    std::string str;
-    unsigned start{0};
-    unsigned end{1};
-
-    while (end <= s.size()) {
-        str = s.substr(start, end - start);
-
-        if (st_.In(str)) {
-            unsigned lookahead = end + 1;
-            while (lookahead <= s.size()) {
-                std::string extended = s.substr(start, lookahead - start);
-                if (st_.In(extended)) {
-                    end = lookahead;
+    return result;
+}
+
+std::shared_ptr<const SymbolTrie> Grammar::Symbols() const {
+    if (!symbol_trie_ || symbol_trie_->SymbolCount() != st_.Size()) {
+        symbol_trie_ = std::make_shared<const SymbolTrie>(st_);
+    }
+    return symbol_trie_;
+}
+
+void Grammar::BuildProductionStore() {
+    analysis_.reset();
+    std::vector<std::pair<SymbolId, const std::vector<production>*>> rules;
+    rules.reserve(g_.size());
+    for (const auto& [nt, prods] : g_) {
+        rules.emplace_back(st_.Intern(nt, false), &prods);
+    }
+    std::sort(rules.begin(), rules.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    store_ = ProductionStore{};
+    store_.non_terminals_.reserve(rules.size());
+    for (const auto& [nt, prods] : rules) {
+        store_.non_terminals_.push_back(nt);
+        for (const production& prod : *prods) {
+            for (const std::string& symbol : prod) {
+                if (symbol != st_.EPSILON_) {
+                    store_.symbols_.push_back(st_.Intern(symbol, false));
                 }
-                ++lookahead;
             }
-            splitted.push_back(s.substr(start, end - start));
-            start = end;
-            end = start + 1;
-        } else {
-            ++end;
+            store_.offsets_.push_back(
+                static_cast<std::uint32_t>(store_.symbols_.size()));
+            store_.lhs_.push_back(nt);
         }
     }
 
-    if (start < end - 1) {
-        return {};
+    // Productions are sorted by antecedent, so counting them per symbol and
+    // accumulating gives the start of each range.
+    store_.ranges_.assign(st_.Size() + 1, 0);
+    for (SymbolId nt : store_.lhs_) {
+        ++store_.ranges_[nt + 1];
+    }
+    for (std::size_t i = 1; i < store_.ranges_.size(); ++i) {
+        store_.ranges_[i] += store_.ranges_[i - 1];
     }
-    return splitted;
+}
+
+ProductionId Grammar::FindProduction(const std::string& antecedent,
+                                     const production&  consequent) const {
+    SymbolId lhs = st_.GetId(antecedent);
+    if (lhs == SymbolTable::NO_SYMBOL) {
+        return ProductionStore::NO_PRODUCTION;
+    }
+    std::vector<SymbolId> rhs;
+    rhs.reserve(consequent.size());
+    for (const std::string& symbol : consequent) {
+        if (symbol == st_.EPSILON_) {
+            continue;
+        }
+        SymbolId id = st_.GetId(symbol);
+        if (id == SymbolTable::NO_SYMBOL) {
+            return ProductionStore::NO_PRODUCTION;
+        }
+        rhs.push_back(id);
+    }
+    for (ProductionId p = store_.Begin(lhs); p < store_.End(lhs); ++p) {
+        std::span<const SymbolId> candidate = store_.Rhs(p);
+        if (std::equal(candidate.begin(), candidate.end(), rhs.begin(),
+                       rhs.end())) {
+            return p;
+        }
+    }
+    return ProductionStore::NO_PRODUCTION;
+}
+
+std::shared_ptr<const GrammarAnalysis> Grammar::Analysis() const {
+    if (!analysis_) {
+        analysis_ = std::make_shared<const GrammarAnalysis>(*this);
+    }
+    return analysis_;
+}
+
+std::unordered_map<std::string, std::vector<production>>
+Grammar::RulesFromStore() const {
+    std::unordered_map<std::string, std::vector<production>> rules;
+    rules.reserve(store_.non_terminals_.size());
+    for (SymbolId nt : store_.non_terminals_) {
+        std::vector<production>& prods = rules[st_.Name(nt)];
+        prods.reserve(store_.End(nt) - store_.Begin(nt));
+        for (ProductionId p = store_.Begin(nt); p < store_.End(nt); ++p) {
+            std::span<const SymbolId> rhs = store_.Rhs(p);
+            if (rhs.empty()) {
+                prods.push_back({st_.EPSILON_});
+                continue;
+            }
+            production& prod = prods.emplace_back();
+            prod.reserve(rhs.size());
+            for (SymbolId symbol : rhs) {
+                prod.push_back(st_.Name(symbol));
+            }
+        }
+    }
+    return rules;
 }
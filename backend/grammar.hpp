@@ -1,12 +1,88 @@
 #pragma once
 #include "symbol_table.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 using production = std::vector<std::string>;
 
+class GrammarAnalysis;
+class SymbolTrie;
+
+/// @brief Dense index of a production in a ProductionStore.
+using ProductionId = std::uint32_t;
+
+/**
+ * @brief Compact representation of the productions of a grammar.
+ *
+ * The right-hand sides of all productions are stored back to back in a single
+ * array of symbol ids, so production p spans [offsets_[p], offsets_[p + 1])
+ * of symbols_. Productions are grouped by antecedent: the productions of a
+ * non-terminal A are the ids in [ranges_[A], ranges_[A + 1]), keeping the
+ * order they have in Grammar::g_. Epsilon productions are stored with an
+ * empty right-hand side.
+ */
+struct ProductionStore {
+    /// @brief Returned by lookups when no production matches.
+    static constexpr ProductionId NO_PRODUCTION =
+        static_cast<ProductionId>(-1);
+
+    /// @brief Right-hand side symbols of every production, concatenated.
+    std::vector<SymbolId> symbols_;
+
+    /// @brief Start of each production in symbols_, plus a final sentinel.
+    std::vector<std::uint32_t> offsets_{0};
+
+    /// @brief Antecedent of each production.
+    std::vector<SymbolId> lhs_;
+
+    /// @brief First production of each symbol, indexed by SymbolId, plus a
+    /// final sentinel. Terminals own an empty range.
+    std::vector<ProductionId> ranges_{0};
+
+    /// @brief Non-terminals that have an entry in Grammar::g_, by id.
+    std::vector<SymbolId> non_terminals_;
+
+    /// @brief Number of productions.
+    std::size_t Size() const { return lhs_.size(); }
+
+    /// @brief Antecedent of production p.
+    SymbolId Lhs(ProductionId p) const { return lhs_[p]; }
+
+    /// @brief Right-hand side of production p, empty for epsilon.
+    std::span<const SymbolId> Rhs(ProductionId p) const {
+        return {symbols_.data() + offsets_[p],
+                symbols_.data() + offsets_[p + 1]};
+    }
+
+    /// @brief First production of the antecedent nt.
+    ProductionId Begin(SymbolId nt) const {
+        return nt + 1 < ranges_.size() ? ranges_[nt] : 0;
+    }
+
+    /// @brief One past the last production of the antecedent nt.
+    ProductionId End(SymbolId nt) const {
+        return nt + 1 < ranges_.size() ? ranges_[nt + 1] : 0;
+    }
+};
+
 struct Grammar {
+    /**
+     * @brief Symbols a string was split into by Split.
+     *
+     * @var symbols The symbols, in order; empty if the string could not be
+     * split.
+     * @var error_position Offset of the first character no symbol name starts
+     * with, or std::string::npos if the whole string was split.
+     */
+    struct SplitResult {
+        std::vector<std::string> symbols;
+        std::size_t              error_position{std::string::npos};
+    };
 
     Grammar() = default;
     explicit Grammar(
@@ -82,7 +158,64 @@ struct Grammar {
     void AddProduction(const std::string&              antecedent,
                        const std::vector<std::string>& consequent);
 
-    std::vector<std::string> Split(const std::string& s);
+    /**
+     * @brief Splits a string written without separators into symbols of the
+     * grammar, taking the longest symbol name at each position.
+     *
+     * The string is read once through the trie returned by Symbols().
+     *
+     * @param s The string to split, e.g. "aEb".
+     * @return The symbols, or the position where no symbol starts.
+     */
+    SplitResult Split(const std::string& s) const;
+
+    /**
+     * @brief Returns the trie of the names in st_, built on first use.
+     *
+     * It is shared with copies of the grammar like Analysis(), and built
+     * again when st_ has gained symbols since.
+     */
+    std::shared_ptr<const SymbolTrie> Symbols() const;
+
+    /**
+     * @brief Rebuilds store_ from g_.
+     *
+     * Every symbol of g_ is interned in st_ first; symbols that were never
+     * put in the symbol table are interned as non-terminals. Must be called
+     * after g_ is modified directly.
+     */
+    void BuildProductionStore();
+
+    /**
+     * @brief Looks up a rule in store_.
+     *
+     * @param antecedent The left-hand side of the rule.
+     * @param consequent The right-hand side of the rule. EPSILON symbols are
+     * ignored, as they are in store_.
+     * @return The id of the production, or ProductionStore::NO_PRODUCTION if
+     * the grammar has no such rule.
+     */
+    ProductionId FindProduction(const std::string& antecedent,
+                                const production&  consequent) const;
+
+    /**
+     * @brief Returns the analysis (nullable, FIRST, FOLLOW, reachability and
+     * productivity) of the grammar, computing it on first use.
+     *
+     * The result is cached and shared with copies of the grammar made
+     * afterwards. It is dropped when the grammar changes, that is, when
+     * BuildProductionStore or SetAxiom are called.
+     */
+    std::shared_ptr<const GrammarAnalysis> Analysis() const;
+
+    /**
+     * @brief Builds the map representation of the grammar from store_.
+     *
+     * @return The rules of store_ in the same shape as g_, with epsilon
+     * productions written as { EPSILON }.
+     */
+    std::unordered_map<std::string, std::vector<production>>
+    RulesFromStore() const;
 
     /**
      * @brief Stores the grammar rules with each antecedent mapped to a list of
@@ -90,10 +223,25 @@ struct Grammar {
      */
     std::unordered_map<std::string, std::vector<production>> g_;
 
+    /**
+     * @brief Flat copy of g_ used by the analyses and parser construction.
+     */
+    ProductionStore store_;
+
     /**
      * @brief The axiom or entry point of the grammar.
      */
     std::string axiom_;
 
     SymbolTable st_;
+
+    /**
+     * @brief Cached result of Analysis(), empty until it is first requested.
+     */
+    mutable std::shared_ptr<const GrammarAnalysis> analysis_;
+
+    /**
+     * @brief Cached result of Symbols(), empty until it is first requested.
+     */
+    mutable std::shared_ptr<const SymbolTrie> symbol_trie_;
 };
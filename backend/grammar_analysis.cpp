@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <span>
+#include <vector>
+
+#include "digraph.hpp"
+#include "grammar.hpp"
+#include "grammar_analysis.hpp"
+#include "symbol_table.hpp"
+#include "terminal_set.hpp"
+
+GrammarAnalysis::GrammarAnalysis(const Grammar& gr) {
+    const SymbolTable& st = gr.st_;
+    terminal_count_       = st.terminal_ids_.size();
+    terminal_index_.assign(st.Size(), NOT_TERMINAL);
+    for (SymbolId id = 0; id < st.Size(); ++id) {
+        if (st.IsTerminal(id)) {
+            terminal_index_[id] = st.TerminalIndex(id);
+        }
+    }
+
+    ComputeFirst(gr.store_);
+    ComputeSuffixes(gr.store_);
+    ComputeFollow(gr);
+    ComputeDerivesEmpty(gr.store_);
+    ComputeLrFirst(gr.store_);
+    ComputeReachable(gr);
+    ComputeProductive(gr.store_);
+}
+
+void GrammarAnalysis::First(std::span<const SymbolId> rule,
+                            TerminalSet&              result) const {
+    for (SymbolId symbol : rule) {
+        if (terminal_index_[symbol] != NOT_TERMINAL) {
+            // EOL cannot be in first sets, if we reach EOL it means that the
+            // axiom is nullable, so epsilon is included instead
+            if (symbol == SymbolTable::EOL_ID) {
+                result.Insert(SymbolTable::EPSILON_INDEX);
+                return;
+            }
+            result.Insert(terminal_index_[symbol]);
+            return;
+        }
+        const TerminalSet& fii = first_[symbol];
+        if (!fii.Contains(SymbolTable::EPSILON_INDEX)) {
+            result.Merge(fii);
+            return;
+        }
+        bool had_epsilon = result.Contains(SymbolTable::EPSILON_INDEX);
+        result.Merge(fii);
+        if (!had_epsilon) {
+            result.Erase(SymbolTable::EPSILON_INDEX);
+        }
+    }
+    result.Insert(SymbolTable::EPSILON_INDEX);
+}
+
+bool GrammarAnalysis::LrFirst(std::span<const SymbolId> rule,
+                              TerminalSet&              result) const {
+    for (SymbolId symbol : rule) {
+        if (terminal_index_[symbol] != NOT_TERMINAL) {
+            result.Insert(terminal_index_[symbol]);
+            return false;
+        }
+        result.Merge(lr_first_[symbol]);
+        if (!derives_empty_[symbol]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GrammarAnalysis::ComputeFirst(const ProductionStore& store) {
+    // Init all FIRST to empty
+    first_.assign(terminal_index_.size(), TerminalSet(terminal_count_));
+
+    TerminalSet rhs_first(terminal_count_);
+    SolveFirst(store, [&](SymbolId nt) {
+        ++first_evaluations_;
+        bool changed = false;
+        for (ProductionId p = store.Begin(nt); p < store.End(nt); ++p) {
+            rhs_first.Clear();
+            First(store.Rhs(p), rhs_first);
+            changed |= first_[nt].Merge(rhs_first);
+        }
+        return changed;
+    });
+}
+
+void GrammarAnalysis::ComputeLrFirst(const ProductionStore& store) {
+    lr_first_.assign(terminal_index_.size(), TerminalSet(terminal_count_));
+
+    SolveFirst(store, [&](SymbolId nt) {
+        bool changed = false;
+        for (ProductionId p = store.Begin(nt); p < store.End(nt); ++p) {
+            std::size_t before = lr_first_[nt].Count();
+            LrFirst(store.Rhs(p), lr_first_[nt]);
+            changed |= lr_first_[nt].Count() != before;
+        }
+        return changed;
+    });
+}
+
+template <typename Evaluate>
+void GrammarAnalysis::SolveFirst(const ProductionStore& store,
+                                 Evaluate               evaluate) {
+    const std::size_t symbols = terminal_index_.size();
+
+    // dependents[X] holds the non-terminals whose FIRST set reads FIRST(X).
+    // A terminal ends what First can read of a production, so only the
+    // symbols before the first terminal are dependencies.
+    std::vector<std::vector<SymbolId>> dependents(symbols);
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        for (SymbolId symbol : store.Rhs(p)) {
+            if (terminal_index_[symbol] != NOT_TERMINAL) {
+                break;
+            }
+            dependents[symbol].push_back(store.Lhs(p));
+        }
+    }
+
+    std::queue<SymbolId>      pending;
+    std::vector<std::uint8_t> queued(symbols, 0);
+    for (SymbolId nt : store.non_terminals_) {
+        pending.push(nt);
+        queued[nt] = 1;
+    }
+
+    while (!pending.empty()) {
+        SymbolId nt = pending.front();
+        pending.pop();
+        queued[nt] = 0;
+        if (!evaluate(nt)) {
+            continue;
+        }
+        for (SymbolId dependent : dependents[nt]) {
+            if (!queued[dependent]) {
+                pending.push(dependent);
+                queued[dependent] = 1;
+            }
+        }
+    }
+}
+
+void GrammarAnalysis::ComputeSuffixes(const ProductionStore& store) {
+    suffix_offsets_.resize(store.Size());
+    std::uint32_t positions = 0;
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        suffix_offsets_[p] = positions;
+        positions += static_cast<std::uint32_t>(store.Rhs(p).size()) + 1;
+    }
+    suffix_first_.assign(positions, TerminalSet(terminal_count_));
+    suffix_nullable_.assign(positions, 0);
+
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        std::span<const SymbolId> rhs  = store.Rhs(p);
+        std::uint32_t             base = suffix_offsets_[p];
+        suffix_nullable_[base + rhs.size()] = 1;
+        for (size_t i = rhs.size(); i-- > 0;) {
+            SymbolId     symbol = rhs[i];
+            TerminalSet& first  = suffix_first_[base + i];
+            if (terminal_index_[symbol] == NOT_TERMINAL) {
+                const TerminalSet& fii = first_[symbol];
+                first.Merge(fii);
+                first.Erase(SymbolTable::EPSILON_INDEX);
+                if (fii.Contains(SymbolTable::EPSILON_INDEX)) {
+                    first.Merge(suffix_first_[base + i + 1]);
+                    suffix_nullable_[base + i] =
+                        suffix_nullable_[base + i + 1];
+                }
+            } else if (symbol == SymbolTable::EOL_ID) {
+                // Same as in First: reaching EOL counts as epsilon
+                suffix_nullable_[base + i] = 1;
+            } else {
+                first.Insert(terminal_index_[symbol]);
+            }
+        }
+    }
+}
+
+void GrammarAnalysis::ComputeFollow(const Grammar& gr) {
+    const ProductionStore& store   = gr.store_;
+    const std::size_t      symbols = terminal_index_.size();
+    follow_.assign(symbols, TerminalSet(terminal_count_));
+    SymbolId axiom = gr.st_.GetId(gr.axiom_);
+    if (axiom != SymbolTable::NO_SYMBOL) {
+        follow_[axiom].Insert(SymbolTable::EOL_INDEX);
+    }
+
+    std::vector<std::vector<std::uint32_t>> includes(symbols);
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        SymbolId                  lhs = store.Lhs(p);
+        std::span<const SymbolId> rhs = store.Rhs(p);
+        for (std::uint32_t i = 0; i < rhs.size(); ++i) {
+            SymbolId symbol = rhs[i];
+            if (terminal_index_[symbol] != NOT_TERMINAL) {
+                continue;
+            }
+            follow_[symbol].Merge(SuffixFirst(p, i + 1));
+            if (SuffixNullable(p, i + 1) && symbol != lhs) {
+                includes[symbol].push_back(lhs);
+            }
+        }
+    }
+    Digraph(includes, follow_);
+}
+
+void GrammarAnalysis::ComputeDerivesEmpty(const ProductionStore& store) {
+    derives_empty_.assign(terminal_index_.size(), 0);
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+        for (ProductionId p = 0; p < store.Size(); ++p) {
+            SymbolId lhs = store.Lhs(p);
+            if (derives_empty_[lhs]) {
+                continue;
+            }
+            std::span<const SymbolId> rhs = store.Rhs(p);
+            if (std::all_of(rhs.begin(), rhs.end(), [&](SymbolId symbol) {
+                    return derives_empty_[symbol] != 0;
+                })) {
+                derives_empty_[lhs] = 1;
+                changed             = true;
+            }
+        }
+    }
+}
+
+void GrammarAnalysis::ComputeReachable(const Grammar& gr) {
+    const ProductionStore& store = gr.store_;
+    reachable_.assign(terminal_index_.size(), 0);
+    std::vector<SymbolId> pending;
+
+    SymbolId axiom = gr.st_.GetId(gr.axiom_);
+    if (axiom != SymbolTable::NO_SYMBOL) {
+        pending.push_back(axiom);
+        reachable_[axiom] = 1;
+    }
+
+    while (!pending.empty()) {
+        SymbolId current = pending.back();
+        pending.pop_back();
+
+        for (ProductionId p = store.Begin(current); p < store.End(current);
+             ++p) {
+            for (SymbolId symbol : store.Rhs(p)) {
+                if (terminal_index_[symbol] == NOT_TERMINAL &&
+                    !reachable_[symbol]) {
+                    reachable_[symbol] = 1;
+                    pending.push_back(symbol);
+                }
+            }
+        }
+    }
+}
+
+void GrammarAnalysis::ComputeProductive(const ProductionStore& store) {
+    productive_.assign(terminal_index_.size(), 0);
+    bool changed = true;
+
+    while (changed) {
+        changed = false;
+        for (SymbolId nt : store.non_terminals_) {
+            if (productive_[nt]) {
+                continue;
+            }
+            for (ProductionId p = store.Begin(nt); p < store.End(nt); ++p) {
+                std::span<const SymbolId> rhs = store.Rhs(p);
+                bool all_productive = std::all_of(
+                    rhs.begin(), rhs.end(), [&](SymbolId symbol) {
+                        return terminal_index_[symbol] != NOT_TERMINAL ||
+                               productive_[symbol];
+                    });
+                if (all_productive) {
+                    productive_[nt] = 1;
+                    changed         = true;
+                    break;
+                }
+            }
+        }
+    }
+}
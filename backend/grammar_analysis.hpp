@@ -0,0 +1,176 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "grammar.hpp"
+#include "terminal_set.hpp"
+
+/**
+ * @class GrammarAnalysis
+ * @brief Nullable symbols, FIRST and FOLLOW sets, reachability and
+ * productivity of a grammar.
+ *
+ * Everything is computed once, from the grammar's ProductionStore, by the
+ * constructor. The object is never modified afterwards, so a single instance
+ * is shared by the parsers and the sanity checks working on the same grammar
+ * (see Grammar::Analysis). Tables are indexed by SymbolId and FIRST/FOLLOW
+ * sets hold terminal indices (see SymbolTable::TerminalIndex).
+ */
+class GrammarAnalysis {
+  public:
+    /**
+     * @brief Analyses a grammar.
+     *
+     * @param gr Grammar to analyse. Its store_ must be up to date.
+     */
+    explicit GrammarAnalysis(const Grammar& gr);
+
+    /// @brief Checks if a symbol can derive the empty string.
+    bool Nullable(SymbolId id) const {
+        return id < first_.size() &&
+               first_[id].Contains(SymbolTable::EPSILON_INDEX);
+    }
+
+    /**
+     * @brief Checks if a symbol derives the empty string when EOL counts as
+     * an ordinary terminal.
+     *
+     * Nullable treats reaching EOL as reaching the end of the input, which is
+     * right for FIRST and FOLLOW. An LR automaton shifts EOL like any other
+     * terminal, so the LR lookahead computations use this one instead; both
+     * only differ for symbols deriving the axiom's $.
+     */
+    bool DerivesEmpty(SymbolId id) const { return derives_empty_[id] != 0; }
+
+    /// @brief FIRST set of a symbol when EOL counts as an ordinary terminal,
+    /// as in DerivesEmpty. It never holds EPSILON.
+    const TerminalSet& LrFirst(SymbolId id) const { return lr_first_[id]; }
+
+    /**
+     * @brief Adds the FIRST set of a sequence of symbol ids to result, EOL
+     * counting as an ordinary terminal.
+     *
+     * @return Whether the whole sequence derives the empty string, see
+     * DerivesEmpty.
+     */
+    bool LrFirst(std::span<const SymbolId> rule, TerminalSet& result) const;
+
+    /// @brief FIRST set of a non-terminal, with EPSILON if it is nullable.
+    const TerminalSet& First(SymbolId id) const { return first_[id]; }
+
+    /**
+     * @brief Calculates the FIRST set of a sequence of symbol ids.
+     *
+     * If the whole sequence can derive the empty string, EPSILON is added.
+     * Reaching EOL counts as reaching the end of the sequence.
+     *
+     * @param rule The symbols whose FIRST set is computed. An empty span
+     * stands for epsilon.
+     * @param result Set where the FIRST terminals are added.
+     */
+    void First(std::span<const SymbolId> rule, TerminalSet& result) const;
+
+    /**
+     * @brief FIRST set of the symbols of production p from position dot on,
+     * read from a table built with the analysis.
+     *
+     * EPSILON is never in the returned set; use SuffixNullable to know if the
+     * suffix can derive the empty string.
+     *
+     * @param p Id of the production in the grammar's ProductionStore.
+     * @param dot Position in the right-hand side, from 0 to its size.
+     */
+    const TerminalSet& SuffixFirst(ProductionId p, std::uint32_t dot) const {
+        return suffix_first_[suffix_offsets_[p] + dot];
+    }
+
+    /// @brief Checks if the symbols of production p from position dot on can
+    /// derive the empty string.
+    bool SuffixNullable(ProductionId p, std::uint32_t dot) const {
+        return suffix_nullable_[suffix_offsets_[p] + dot] != 0;
+    }
+
+    /// @brief FOLLOW set of a non-terminal.
+    const TerminalSet& Follow(SymbolId id) const { return follow_[id]; }
+
+    /// @brief Checks if a non-terminal can be reached from the axiom.
+    bool Reachable(SymbolId id) const { return reachable_[id] != 0; }
+
+    /// @brief Checks if a non-terminal derives at least one terminal string.
+    bool Productive(SymbolId id) const { return productive_[id] != 0; }
+
+    /// @brief Number of symbols analysed; valid SymbolIds are below it.
+    std::size_t SymbolCount() const { return first_.size(); }
+
+    /// @brief Number of terminal indices the sets were created for.
+    std::size_t TerminalCount() const { return terminal_count_; }
+
+    /// @brief Number of non-terminal evaluations needed to compute FIRST.
+    std::size_t FirstEvaluations() const { return first_evaluations_; }
+
+  private:
+    /// @brief Marks a symbol that is not a terminal in terminal_index_.
+    static constexpr std::uint32_t NOT_TERMINAL =
+        static_cast<std::uint32_t>(-1);
+
+    /**
+     * @brief Least fixed point of the FIRST sets, driven by a worklist of
+     * non-terminals. A non-terminal is only evaluated again when the FIRST
+     * set of a symbol its productions read has grown.
+     */
+    void ComputeFirst(const ProductionStore& store);
+
+    /// @brief Least fixed point of the LrFirst sets, with the worklist of
+    /// ComputeFirst.
+    void ComputeLrFirst(const ProductionStore& store);
+
+    /**
+     * @brief Worklist of the FIRST fixed points. Every non-terminal is
+     * evaluated once, then again whenever a symbol read by its productions
+     * was evaluated and its set grew.
+     *
+     * @param evaluate Recomputes the set of a non-terminal, returning
+     * whether it grew.
+     */
+    template <typename Evaluate>
+    void SolveFirst(const ProductionStore& store, Evaluate evaluate);
+
+    /**
+     * @brief Fills the suffix tables, walking each right-hand side backwards
+     * from its end.
+     */
+    void ComputeSuffixes(const ProductionStore& store);
+
+    /**
+     * @brief Computes the FOLLOW sets. For every A → αBβ, FIRST(β) is added
+     * to FOLLOW(B) and, when β is nullable, FOLLOW(B) includes FOLLOW(A); the
+     * includes relation is then solved by Digraph.
+     */
+    void ComputeFollow(const Grammar& gr);
+
+    void ComputeDerivesEmpty(const ProductionStore& store);
+    void ComputeReachable(const Grammar& gr);
+    void ComputeProductive(const ProductionStore& store);
+
+    /// @brief Terminal index of each terminal, NOT_TERMINAL otherwise.
+    std::vector<std::uint32_t> terminal_index_;
+
+    std::size_t               terminal_count_{0};
+    std::vector<TerminalSet>  first_;
+    std::vector<TerminalSet>  follow_;
+    std::vector<TerminalSet>  lr_first_;
+
+    /// @brief Position of the suffix of every production at dot 0 in
+    /// suffix_first_ and suffix_nullable_. Production p owns
+    /// |rhs(p)| + 1 entries.
+    std::vector<std::uint32_t> suffix_offsets_;
+
+    std::vector<TerminalSet>  suffix_first_;
+    std::vector<std::uint8_t> suffix_nullable_;
+    std::vector<std::uint8_t> derives_empty_;
+    std::vector<std::uint8_t> reachable_;
+    std::vector<std::uint8_t> productive_;
+    std::size_t               first_evaluations_{0};
+};
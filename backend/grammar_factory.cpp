@@ -1,8 +1,11 @@
+#include "grammar_analysis.hpp"
 #include "grammar_factory.hpp"
 #include "ll1_parser.hpp"
 #include "slr1_parser.hpp"
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <random>
 
@@ -71,18 +74,17 @@ Grammar GrammarFactory::PickOne(int level) {
 }
 
 Grammar GrammarFactory::GenLL1Grammar(int level) {
-    Grammar   gr = PickOne(level);
-    LL1Parser ll1(gr);
+    Grammar gr = PickOne(level);
+    // The checks run on gr first, so the parsers built from its copies reuse
+    // the analysis they computed
     while (IsInfinite(gr) || HasUnreachableSymbols(gr) ||
-           HasDirectLeftRecursion(gr) || !ll1.CreateLL1Table()) {
+           HasDirectLeftRecursion(gr) || !LL1Parser(gr).CreateLL1Table()) {
         RemoveLeftRecursion(gr);
-        ll1 = LL1Parser(gr);
-        if (ll1.CreateLL1Table()) {
+        if (LL1Parser(gr).CreateLL1Table()) {
             break;
         }
         LeftFactorize(gr);
-        ll1 = LL1Parser(gr);
-        if (ll1.CreateLL1Table()) {
+        if (LL1Parser(gr).CreateLL1Table()) {
             break;
         }
         gr = PickOne(level);
@@ -91,12 +93,10 @@ Grammar GrammarFactory::GenLL1Grammar(int level) {
 }
 
 Grammar GrammarFactory::GenSLR1Grammar(int level) {
-    Grammar    gr = PickOne(level);
-    SLR1Parser slr1(gr);
-
-    while (IsInfinite(gr) || HasUnreachableSymbols(gr) || !slr1.MakeParser()) {
-        gr   = PickOne(level);
-        slr1 = SLR1Parser(gr);
+    Grammar gr = PickOne(level);
+    while (IsInfinite(gr) || HasUnreachableSymbols(gr) ||
+           !SLR1Parser(gr).MakeParser()) {
+        gr = PickOne(level);
     }
     return gr;
 }
@@ -675,32 +675,10 @@ GrammarFactory::FactoryItem GrammarFactory::CreateLv2Item() {
 }
 
 bool GrammarFactory::HasUnreachableSymbols(Grammar& grammar) {
-    std::unordered_set<std::string> reachable;
-    std::queue<std::string>         pending;
-
-    pending.push(grammar.axiom_);
-    reachable.insert(grammar.axiom_);
-
-    while (!pending.empty()) {
-        std::string current = pending.front();
-        pending.pop();
-
-        auto it = grammar.g_.find(current);
-        if (it != grammar.g_.end()) {
-            for (const auto& production : it->second) {
-                for (const auto& symbol : production) {
-                    if (!grammar.st_.IsTerminal(symbol) &&
-                        reachable.find(symbol) == reachable.end()) {
-                        reachable.insert(symbol);
-                        pending.push(symbol);
-                    }
-                }
-            }
-        }
-    }
-
+    std::shared_ptr<const GrammarAnalysis> analysis = grammar.Analysis();
     for (const auto& nt : grammar.st_.non_terminals_) {
-        if (reachable.find(nt) == reachable.end()) {
+        SymbolId id = grammar.st_.GetId(nt);
+        if (id == SymbolTable::NO_SYMBOL || !analysis->Reachable(id)) {
             return true;
         }
     }
@@ -708,71 +686,63 @@ bool GrammarFactory::HasUnreachableSymbols(Grammar& grammar) {
 }
 
 bool GrammarFactory::IsInfinite(Grammar& grammar) {
-    std::unordered_set<std::string> generating;
-    bool                            changed = true;
-
-    while (changed) {
-        changed = false;
-        for (const auto& [nt, productions] : grammar.g_) {
-            if (generating.find(nt) != generating.end()) {
-                continue;
-            }
-            for (const auto& prod : productions) {
-                bool all_generating = true;
-                for (const auto& symbol : prod) {
-                    if (!grammar.st_.IsTerminal(symbol) &&
-                        generating.find(symbol) == generating.end()) {
-                        all_generating = false;
-                        break;
-                    }
-                }
-                if (all_generating) {
-                    generating.insert(nt);
-                    changed = true;
-                    break;
-                }
-            }
-        }
-    }
+    std::shared_ptr<const GrammarAnalysis> analysis = grammar.Analysis();
     // Counterexample:  S -> A; A -> B A c | e; B -> B a | B. Axiom can derive
     // into a terminal string (A -> e) return generating.find(grammar.axiom_) ==
     // generating.end();
-    return generating != grammar.st_.non_terminals_;
+    for (const auto& nt : grammar.st_.non_terminals_) {
+        SymbolId id = grammar.st_.GetId(nt);
+        if (id == SymbolTable::NO_SYMBOL || !analysis->Productive(id)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool GrammarFactory::HasDirectLeftRecursion(Grammar& grammar) {
-    for (const auto& [nt, prods] : grammar.g_) {
-        for (const auto& prod : prods) {
-            if (nt == prod[0]) {
-                return true;
-            }
+    const ProductionStore& store = grammar.store_;
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        std::span<const SymbolId> rhs = store.Rhs(p);
+        if (!rhs.empty() && rhs[0] == store.Lhs(p)) {
+            return true;
         }
     }
     return false;
 }
 
 bool GrammarFactory::HasIndirectLeftRecursion(Grammar& grammar) {
-    std::unordered_set<std::string> nullable = NullableSymbols(grammar);
-    std::unordered_map<std::string, std::unordered_set<std::string>> graph;
+    const ProductionStore&                 store    = grammar.store_;
+    std::shared_ptr<const GrammarAnalysis> analysis = grammar.Analysis();
+    std::vector<std::vector<SymbolId>>     graph(grammar.st_.Size());
 
-    for (const auto& [nt, productions] : grammar.g_) {
-        graph[nt] = {};
-        for (const production& prod : productions) {
-            if (!grammar.st_.IsTerminal(prod[0])) {
-                graph[nt].insert(prod[0]);
+    auto add_edge = [&graph](SymbolId from, SymbolId to) {
+        std::vector<SymbolId>& adjacents = graph[from];
+        if (std::find(adjacents.begin(), adjacents.end(), to) ==
+            adjacents.end()) {
+            adjacents.push_back(to);
+        }
+    };
+
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        SymbolId                  nt   = store.Lhs(p);
+        std::span<const SymbolId> prod = store.Rhs(p);
+        if (prod.empty()) {
+            continue;
+        }
+        if (!grammar.st_.IsTerminal(prod[0])) {
+            add_edge(nt, prod[0]);
+        }
+        for (size_t i = 1; i < prod.size(); ++i) {
+            if (grammar.st_.IsTerminal(prod[i])) {
+                break;
             }
-            for (size_t i = 1; i < prod.size(); ++i) {
-                if (grammar.st_.IsTerminal(prod[i])) {
-                    break;
-                }
-                graph[nt].insert(prod[i]);
-                if (!nullable.count(prod[i])) {
-                    break;
-                }
+            add_edge(nt, prod[i]);
+            if (!analysis->Nullable(prod[i])) {
+                break;
             }
         }
     }
-    return !graph.empty() && HasCycle(graph);
+    return !store.non_terminals_.empty() && HasCycle(graph);
 }
 
 bool GrammarFactory::HasCycle(
@@ -812,38 +782,46 @@ bool GrammarFactory::HasCycle(
     return static_cast<size_t>(processed_nodes) != in_degree.size();
 }
 
-std::unordered_set<std::string>
-GrammarFactory::NullableSymbols(Grammar& grammar) {
-    std::unordered_set<std::string> nullable;
-    bool                            changed;
+bool GrammarFactory::HasCycle(const std::vector<std::vector<SymbolId>>& graph) {
+    std::vector<unsigned> in_degree(graph.size(), 0);
+    std::vector<SymbolId> pending;
 
-    nullable.reserve(grammar.st_.non_terminals_.size());
-    do {
-        changed = false;
-        for (const auto& [nt, productions] : grammar.g_) {
-            if (nullable.count(nt)) {
-                continue;
-            }
-            for (const production& prod : productions) {
-                if (prod.size() == 1 && prod[0] == grammar.st_.EPSILON_) {
-                    nullable.insert(nt);
-                    changed = true;
-                } else {
-                    bool all_nullable = true;
-                    for (const std::string& sym : prod) {
-                        if (!nullable.count(sym) && sym != grammar.st_.EOL_) {
-                            all_nullable = false;
-                            break;
-                        }
-                    }
-                    if (all_nullable) {
-                        nullable.insert(nt);
-                        changed = true;
-                    }
-                }
+    for (const auto& adjacents : graph) {
+        for (SymbolId adj : adjacents) {
+            in_degree[adj]++;
+        }
+    }
+
+    for (SymbolId node = 0; node < graph.size(); ++node) {
+        if (in_degree[node] == 0) {
+            pending.push_back(node);
+        }
+    }
+
+    size_t processed_nodes = 0;
+    while (!pending.empty()) {
+        SymbolId node = pending.back();
+        pending.pop_back();
+        processed_nodes++;
+
+        for (SymbolId adj : graph[node]) {
+            if (--in_degree[adj] == 0) {
+                pending.push_back(adj);
             }
         }
-    } while (changed);
+    }
+    return processed_nodes != graph.size();
+}
+
+std::unordered_set<std::string>
+GrammarFactory::NullableSymbols(Grammar& grammar) {
+    std::shared_ptr<const GrammarAnalysis> analysis = grammar.Analysis();
+    std::unordered_set<std::string>        nullable;
+    for (SymbolId nt : grammar.store_.non_terminals_) {
+        if (analysis->Nullable(nt)) {
+            nullable.insert(grammar.st_.Name(nt));
+        }
+    }
     return nullable;
 }
 
@@ -887,6 +865,7 @@ void GrammarFactory::RemoveLeftRecursion(Grammar& grammar) {
     // EPSILON was introduced to the grammar, ensure it is in the symbol table
     grammar.st_.PutSymbol(grammar.st_.EPSILON_, true);
     grammar.g_ = std::move(new_rules);
+    grammar.BuildProductionStore();
 }
 
 void GrammarFactory::RemoveUnitRules(Grammar& grammar) {
@@ -894,9 +873,11 @@ void GrammarFactory::RemoveUnitRules(Grammar& grammar) {
         for (const auto& prod : prods) {
             if (prod.size() == 1 && !grammar.st_.IsTerminal(prod[0])) {
                 grammar.g_[nt] = grammar.g_.at(prod[0]);
+                grammar.BuildProductionStore();
                 if (HasUnreachableSymbols(grammar)) {
                     grammar.g_.erase(prod[0]);
                     grammar.st_.non_terminals_.erase(prod[0]);
+                    grammar.BuildProductionStore();
                 }
             }
         }
@@ -956,6 +937,7 @@ void GrammarFactory::LeftFactorize(Grammar& grammar) {
 
         grammar.g_ = std::move(new_rules);
     } while (changed);
+    grammar.BuildProductionStore();
 }
 
 std::vector<std::string> GrammarFactory::LongestCommonPrefix(
@@ -212,6 +212,14 @@ struct GrammarFactory {
     HasCycle(const std::unordered_map<std::string,
                                       std::unordered_set<std::string>>& graph);
 
+    /**
+     * @brief Checks if a directed graph over symbol ids has a cycle using
+     * topological sort.
+     * @param graph Adjacency lists indexed by SymbolId.
+     * @return true if the graph has a cycle.
+     */
+    bool HasCycle(const std::vector<std::vector<SymbolId>>& graph);
+
     /**
      * @brief Find nullable symbols in a grammar.
      * @param grammar The grammar to check.
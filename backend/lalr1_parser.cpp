@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <map>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "digraph.hpp"
+#include "grammar.hpp"
+#include "lalr1_parser.hpp"
+#include "slr1_parser.hpp"
+#include "symbol_table.hpp"
+#include "terminal_set.hpp"
+
+LALR1Parser::LALR1Parser(Grammar gr) : SLR1Parser(std::move(gr)) {}
+
+bool LALR1Parser::MakeParser() {
+    MakeAutomaton();
+    ComputeLookaheads();
+    no_lookahead_ = TerminalSet(action_columns_);
+
+    for (const state& st : states_) {
+        for (const Lr0ItemRef& ref : st.closure_) {
+            if (!AddItemActions(st, ref, Lookahead(st.id_, ref.production_))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const TerminalSet& LALR1Parser::Lookahead(unsigned int state,
+                                          ProductionId p) const {
+    auto it = lookaheads_.find({state, p});
+    return it != lookaheads_.end() ? it->second : no_lookahead_;
+}
+
+void LALR1Parser::ComputeLookaheads() {
+    const ProductionStore& store = gr_.store_;
+    const SymbolTable&     st    = gr_.st_;
+    SymbolId               axiom = st.GetId(gr_.axiom_);
+
+    // Number the non-terminal transitions (p, A), laid out like dense_gotos_
+    std::vector<std::uint32_t>                  index(dense_gotos_.size());
+    std::vector<std::pair<unsigned int, SymbolId>> transitions;
+    for (unsigned int p = 0; p < states_.size(); ++p) {
+        for (SymbolId nt : st.non_terminal_ids_) {
+            if (GotoAt(p, nt) != NO_STATE) {
+                index[p * goto_columns_ + st.NonTerminalIndex(nt)] =
+                    static_cast<std::uint32_t>(transitions.size());
+                transitions.emplace_back(p, nt);
+            }
+        }
+    }
+    auto transition = [&](unsigned int p, SymbolId nt) {
+        return index[p * goto_columns_ + st.NonTerminalIndex(nt)];
+    };
+    // Only shifts are in dense_actions_ until the reductions are added
+    auto go = [&](unsigned int p, SymbolId symbol) -> std::uint32_t {
+        return st.IsTerminal(symbol) ? ActionTarget(ActionAt(p, symbol))
+                                     : GotoAt(p, symbol);
+    };
+
+    // Read(p, A) = DR(p, A) ∪ ⋃{ Read(r, C) | (p, A) reads (r, C) }
+    std::vector<TerminalSet> follow(transitions.size(),
+                                    TerminalSet(action_columns_));
+    std::vector<std::vector<std::uint32_t>> reads(transitions.size());
+    for (std::uint32_t t = 0; t < transitions.size(); ++t) {
+        const auto [p, nt] = transitions[t];
+        unsigned int        r   = GotoAt(p, nt);
+        const PackedAction* row = &dense_actions_[r * action_columns_];
+        for (std::uint32_t terminal = 0; terminal < action_columns_;
+             ++terminal) {
+            if (ActionKind(row[terminal]) == Action::Shift) {
+                follow[t].Insert(terminal);
+            }
+        }
+        // Reaching the end of the axiom, the input must end
+        for (const Lr0ItemRef& item : states_[r].closure_) {
+            if (store.Lhs(item.production_) == axiom &&
+                item.IsComplete(store)) {
+                follow[t].Insert(SymbolTable::EOL_INDEX);
+            }
+        }
+        for (SymbolId next : st.non_terminal_ids_) {
+            if (analysis_->DerivesEmpty(next) && GotoAt(r, next) != NO_STATE) {
+                reads[t].push_back(transition(r, next));
+            }
+        }
+    }
+    Digraph(reads, follow);
+
+    // Follow(p, A) = Read(p, A) ∪ ⋃{ Follow(p', B) | (p, A) includes (p', B) }
+    std::vector<std::vector<std::uint32_t>> includes(transitions.size());
+    std::map<std::pair<unsigned int, ProductionId>, std::vector<std::uint32_t>>
+        lookback;
+    std::vector<std::uint8_t> nullable_from;
+    for (std::uint32_t t = 0; t < transitions.size(); ++t) {
+        const auto [p, nt] = transitions[t];
+        for (ProductionId prod = store.Begin(nt); prod < store.End(nt);
+             ++prod) {
+            std::span<const SymbolId> rhs = store.Rhs(prod);
+            // nullable_from[i]: rhs[i..] derives the empty string
+            nullable_from.assign(rhs.size() + 1, 1);
+            for (std::size_t i = rhs.size(); i-- > 0;) {
+                nullable_from[i] =
+                    nullable_from[i + 1] && analysis_->DerivesEmpty(rhs[i]);
+            }
+            unsigned int q = p;
+            for (std::uint32_t i = 0; i < rhs.size(); ++i) {
+                if (!st.IsTerminal(rhs[i]) && nullable_from[i + 1]) {
+                    includes[transition(q, rhs[i])].push_back(t);
+                }
+                q = go(q, rhs[i]);
+            }
+            lookback[{q, prod}].push_back(t);
+        }
+    }
+    Digraph(includes, follow);
+
+    lookaheads_.clear();
+    for (const auto& [reduction, sources] : lookback) {
+        TerminalSet lookahead(action_columns_);
+        for (std::uint32_t t : sources) {
+            lookahead.Merge(follow[t]);
+        }
+        lookaheads_.emplace(reduction, std::move(lookahead));
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <map>
+#include <utility>
+
+#include "grammar.hpp"
+#include "slr1_parser.hpp"
+#include "terminal_set.hpp"
+
+/**
+ * @class LALR1Parser
+ * @brief LALR(1) parser built on the LR(0) automaton of SLR1Parser.
+ *
+ * States, transitions and the layout of the action tables are the ones of
+ * SLR1Parser, so anything displaying an SLR(1) table can display this one.
+ * Only the terminals a reduction is made on change: instead of FOLLOW of the
+ * left-hand side, each reduction gets its LALR(1) lookahead, computed with
+ * the relations of DeRemer and Pennello over the non-terminal transitions
+ * (p, A) of the automaton:
+ *
+ * - DR(p, A): terminals shifted from goto(p, A).
+ * - (p, A) reads (r, C) if r = goto(p, A) and C is nullable.
+ * - (p, B) includes (p', A) if A → βBγ, γ is nullable and p' reaches p
+ *   through β.
+ * - (q, A → ω) lookback (p, A) if p reaches q through ω.
+ *
+ * Read and Follow are both solved with Digraph, and the lookahead of a
+ * reduction is the union of Follow over its lookback transitions.
+ */
+class LALR1Parser : public SLR1Parser {
+  public:
+    LALR1Parser() = default;
+    LALR1Parser(Grammar gr);
+
+    /**
+     * @brief Builds the LR(0) automaton, its LALR(1) lookaheads and the
+     * action table.
+     *
+     * @return `true` if the grammar is LALR(1), `false` if an action
+     * conflict remains.
+     */
+    bool MakeParser() override;
+
+    /**
+     * @brief Fills lookaheads_ from the automaton built by MakeAutomaton.
+     */
+    void ComputeLookaheads();
+
+    /**
+     * @brief LALR(1) lookahead of the reduction by production p in a state.
+     *
+     * @return The terminal indices to reduce on, empty if p is not reduced
+     * in that state.
+     */
+    const TerminalSet& Lookahead(unsigned int state, ProductionId p) const;
+
+    /// @brief Lookahead of each reduction, by state and production.
+    std::map<std::pair<unsigned int, ProductionId>, TerminalSet> lookaheads_;
+
+  private:
+    /// @brief Returned by Lookahead for reductions without lookahead.
+    TerminalSet no_lookahead_;
+};
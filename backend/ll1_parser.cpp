@@ -1,15 +1,20 @@
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <span>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "grammar.hpp"
+#include "grammar_analysis.hpp"
 #include "ll1_parser.hpp"
 #include "symbol_table.hpp"
 #include "tabulate.hpp"
+#include "terminal_set.hpp"
 
 LL1Parser::LL1Parser(Grammar gr) : gr_(std::move(gr)) {
     ComputeFirstSets();
@@ -21,149 +26,168 @@ bool LL1Parser::CreateLL1Table() {
         ComputeFirstSets();
         ComputeFollowSets();
     }
-    size_t nrows{gr_.g_.size()};
-    ll1_t_.reserve(nrows);
+    const ProductionStore& store = gr_.store_;
+    const SymbolTable&     st    = gr_.st_;
+    ll1_t_.reserve(store.non_terminals_.size());
+    table_columns_ = st.terminal_ids_.size();
+    dense_table_.assign(st.non_terminal_ids_.size() * table_columns_,
+                        NO_PRODUCTION);
     bool has_conflict{false};
-    for (const auto& rule : gr_.g_) {
+    for (SymbolId nt : store.non_terminals_) {
+        const std::string&             antecedent = st.Name(nt);
+        const std::vector<production>& rules      = gr_.g_.at(antecedent);
         std::unordered_map<std::string, std::vector<production>> column;
-        for (const production& p : rule.second) {
-            std::unordered_set<std::string> ds =
-                PredictionSymbols(rule.first, p);
-            column.reserve(ds.size());
-            for (const std::string& symbol : ds) {
-                auto& cell = column[symbol];
+        for (ProductionId p = store.Begin(nt); p < store.End(nt); ++p) {
+            TerminalSet ds = PredictionSymbols(p);
+            column.reserve(ds.Count());
+            ds.ForEach([&](std::uint32_t terminal) {
+                auto& cell = column[st.Name(st.terminal_ids_[terminal])];
                 if (!cell.empty()) {
                     has_conflict = true;
+                } else {
+                    dense_table_[st.NonTerminalIndex(nt) * table_columns_ +
+                                 terminal] = p;
                 }
-                cell.push_back(p);
-            }
+                cell.push_back(rules[p - store.Begin(nt)]);
+            });
         }
-        ll1_t_.insert({rule.first, column});
+        ll1_t_.insert({antecedent, column});
     }
+    parse_stacks_ = MakeParseStacks();
     return !has_conflict;
 }
 
-void LL1Parser::First(std::span<const std::string>     rule,
-                      std::unordered_set<std::string>& result) {
-    if (rule.empty() || (rule.size() == 1 && rule[0] == gr_.st_.EPSILON_)) {
-        result.insert(gr_.st_.EPSILON_);
-        return;
-    }
-
-    if (rule.size() > 1 && rule[0] == gr_.st_.EPSILON_) {
-        First(std::span<const std::string>(rule.begin() + 1, rule.end()),
-              result);
-    } else {
-
-        if (gr_.st_.IsTerminal(rule[0])) {
-            // EOL cannot be in first sets, if we reach EOL it means that the
-            // axiom is nullable, so epsilon is included instead
-            if (rule[0] == gr_.st_.EOL_) {
-                result.insert(gr_.st_.EPSILON_);
-                return;
+LL1Parser::ParseResult LL1Parser::Parse(std::span<const SymbolId> tokens,
+                                        ParseStacks& stacks) const {
+    const ProductionStore&     store       = gr_.store_;
+    const SymbolTable&         st          = gr_.st_;
+    std::vector<SymbolId>&     parse_stack = stacks.symbols;
+    std::vector<ProductionId>& derivation  = stacks.derivation;
+    TerminalSet                expected(st.terminal_ids_.size());
+    parse_stack.clear();
+    derivation.clear();
+    parse_stack.push_back(st.GetId(gr_.axiom_));
+
+    // The input is tokens and the EOL closing the axiom; the end marker
+    // after it is read as EOL too, but cannot be matched
+    const std::size_t length   = tokens.size() + 1;
+    std::size_t       position = 0;
+    // Productions applied since the last match, for the expected set
+    std::size_t since_match = 0;
+
+    auto fail = [&]() -> ParseResult {
+        // Everything the popped non-terminals could start with was valid, as
+        // is what the stack can start with from its top down. The stack is
+        // only empty once the EOL of the axiom was matched, so nothing more
+        // was valid there, even if that EOL was a token and input remains.
+        for (std::size_t i = since_match; i < derivation.size(); ++i) {
+            expected.Merge(analysis_->First(store.Lhs(derivation[i])));
+        }
+        bool nullable = true;
+        for (std::size_t i = parse_stack.size(); nullable && i-- > 0;) {
+            SymbolId symbol = parse_stack[i];
+            if (st.IsTerminal(symbol)) {
+                expected.Insert(st.TerminalIndex(symbol));
+                nullable = false;
+            } else {
+                expected.Merge(analysis_->First(symbol));
+                nullable = analysis_->Nullable(symbol);
             }
-            result.insert(rule[0]);
-            return;
         }
-
-        const std::unordered_set<std::string>& fii = first_sets_[rule[0]];
-        for (const auto& s : fii) {
-            if (s != gr_.st_.EPSILON_) {
-                result.insert(s);
+        expected.Erase(SymbolTable::EPSILON_INDEX);
+        if (nullable && !parse_stack.empty()) {
+            expected.Insert(SymbolTable::EOL_INDEX);
+        }
+        return {false, std::min(position, tokens.size()), derivation,
+                std::move(expected)};
+    };
+
+    while (!parse_stack.empty()) {
+        SymbolId token =
+            position < tokens.size() ? tokens[position] : SymbolTable::EOL_ID;
+        if (token >= st.Size() || !st.IsTerminal(token)) {
+            return fail();
+        }
+        SymbolId top = parse_stack.back();
+        if (st.IsTerminal(top)) {
+            if (top != token || position == length) {
+                return fail();
             }
+            parse_stack.pop_back();
+            ++position;
+            since_match = derivation.size();
+            continue;
         }
-
-        if (fii.find(gr_.st_.EPSILON_) == fii.cend()) {
-            return;
+        ProductionId p =
+            dense_table_[st.NonTerminalIndex(top) * table_columns_ +
+                         st.TerminalIndex(token)];
+        if (p == NO_PRODUCTION) {
+            return fail();
         }
-        First(std::span<const std::string>(rule.begin() + 1, rule.end()),
-              result);
+        parse_stack.pop_back();
+        std::span<const SymbolId> rhs = store.Rhs(p);
+        parse_stack.insert(parse_stack.end(), rhs.rbegin(), rhs.rend());
+        derivation.push_back(p);
+    }
+    if (position != length) {
+        return fail();
     }
+    return {true, 0, derivation, std::move(expected)};
 }
 
-// Least fixed point
-void LL1Parser::ComputeFirstSets() {
-    // Init all FIRST to empty
-    for (const auto& [nonTerminal, _] : gr_.g_) {
-        first_sets_[nonTerminal] = {};
+void LL1Parser::First(std::span<const std::string>     rule,
+                      std::unordered_set<std::string>& result) {
+    if (!analysis_) {
+        return;
     }
-
-    bool changed;
-    do {
-        auto old_first_sets = first_sets_; // Copy current state
-
-        for (const auto& [nonTerminal, productions] : gr_.g_) {
-            for (const auto& prod : productions) {
-                std::unordered_set<std::string> tempFirst;
-                First(prod, tempFirst);
-
-                if (tempFirst.find(gr_.st_.EOL_) != tempFirst.end()) {
-                    tempFirst.erase(gr_.st_.EOL_);
-                    tempFirst.insert(gr_.st_.EPSILON_);
-                }
-
-                auto& current_set = first_sets_[nonTerminal];
-                current_set.insert(tempFirst.begin(), tempFirst.end());
-            }
+    const SymbolTable&    st = gr_.st_;
+    std::vector<SymbolId> ids;
+    ids.reserve(rule.size());
+    bool truncated = false;
+    for (const std::string& symbol : rule) {
+        if (symbol == st.EPSILON_) {
+            continue;
+        }
+        SymbolId id = st.GetId(symbol);
+        // A symbol without FIRST set ends the string and cannot derive
+        // epsilon
+        if (id == SymbolTable::NO_SYMBOL ||
+            (!st.IsTerminal(id) && id >= analysis_->SymbolCount())) {
+            truncated = true;
+            break;
         }
+        ids.push_back(id);
+    }
+    TerminalSet bits(analysis_->TerminalCount());
+    First(ids, bits);
+    if (truncated) {
+        bits.Erase(SymbolTable::EPSILON_INDEX);
+    }
+    result.merge(bits.ToStrings(st));
+}
 
-        // Until all remain the same
-        changed = (old_first_sets != first_sets_);
+void LL1Parser::First(std::span<const SymbolId> rule,
+                      TerminalSet&              result) const {
+    analysis_->First(rule, result);
+}
 
-    } while (changed);
+void LL1Parser::ComputeFirstSets() {
+    analysis_             = gr_.Analysis();
+    const SymbolTable& st = gr_.st_;
+    for (SymbolId nt : gr_.store_.non_terminals_) {
+        first_sets_[st.Name(nt)] = analysis_->First(nt).ToStrings(st);
+    }
 }
 
 void LL1Parser::ComputeFollowSets() {
-    for (const auto& [nt, _] : gr_.g_) {
-        follow_sets_[nt] = {};
-    }
-    follow_sets_[gr_.axiom_].insert(gr_.st_.EOL_);
-
-    bool changed;
-    do {
-        changed = false;
-        for (const auto& rule : gr_.g_) {
-            const std::string& lhs = rule.first;
-            for (const production& rhs : rule.second) {
-                for (size_t i = 0; i < rhs.size(); ++i) {
-                    const std::string& symbol = rhs[i];
-                    if (!gr_.st_.IsTerminal(symbol)) {
-                        std::unordered_set<std::string> first_remaining;
-
-                        if (i + 1 < rhs.size()) {
-                            First(std::span<const std::string>(
-                                      rhs.begin() + i + 1, rhs.end()),
-                                  first_remaining);
-                        } else {
-                            first_remaining.insert(gr_.st_.EPSILON_);
-                        }
-
-                        for (const std::string& terminal : first_remaining) {
-                            if (terminal != gr_.st_.EPSILON_) {
-                                if (follow_sets_[symbol]
-                                        .insert(terminal)
-                                        .second) {
-                                    changed = true;
-                                }
-                            }
-                        }
-
-                        if (first_remaining.find(gr_.st_.EPSILON_) !=
-                            first_remaining.end()) {
-                            for (const std::string& terminal :
-                                 follow_sets_[lhs]) {
-                                if (follow_sets_[symbol]
-                                        .insert(terminal)
-                                        .second) {
-                                    changed = true;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    } while (changed);
+    analysis_             = gr_.Analysis();
+    const SymbolTable& st = gr_.st_;
+    for (SymbolId nt : gr_.store_.non_terminals_) {
+        follow_sets_[st.Name(nt)] = analysis_->Follow(nt).ToStrings(st);
+    }
+    if (st.GetId(gr_.axiom_) == SymbolTable::NO_SYMBOL) {
+        follow_sets_[gr_.axiom_].insert(st.EOL_);
+    }
 }
 
 std::unordered_set<std::string> LL1Parser::Follow(const std::string& arg) {
@@ -176,6 +200,10 @@ std::unordered_set<std::string> LL1Parser::Follow(const std::string& arg) {
 std::unordered_set<std::string>
 LL1Parser::PredictionSymbols(const std::string&              antecedent,
                              const std::vector<std::string>& consequent) {
+    ProductionId p = gr_.FindProduction(antecedent, consequent);
+    if (analysis_ && p != ProductionStore::NO_PRODUCTION) {
+        return PredictionSymbols(p).ToStrings(gr_.st_);
+    }
     std::unordered_set<std::string> hd{};
     First({consequent}, hd);
     if (hd.find(gr_.st_.EPSILON_) == hd.end()) {
@@ -186,6 +214,14 @@ LL1Parser::PredictionSymbols(const std::string&              antecedent,
     return hd;
 }
 
+TerminalSet LL1Parser::PredictionSymbols(ProductionId p) const {
+    TerminalSet hd = analysis_->SuffixFirst(p, 0);
+    if (analysis_->SuffixNullable(p, 0)) {
+        hd.Merge(analysis_->Follow(gr_.store_.Lhs(p)));
+    }
+    return hd;
+}
+
 std::string LL1Parser::TeachFirst(const std::vector<std::string>& symbols) {
     std::ostringstream output;
 
@@ -1,5 +1,10 @@
 #pragma once
 #include "grammar.hpp"
+#include "grammar_analysis.hpp"
+#include "terminal_set.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <span>
 #include <stack>
 #include <string>
@@ -28,6 +33,44 @@ class LL1Parser {
         std::string, std::unordered_map<std::string, std::vector<production>>>;
 
   public:
+    /// @brief Cell of the dense LL(1) table without a production.
+    static constexpr ProductionId NO_PRODUCTION =
+        static_cast<ProductionId>(-1);
+
+    /**
+     * @brief Outcome of Parse.
+     *
+     * @var accepted Whether the input is a sentence of the grammar.
+     * @var error_position Index of the token that could not be predicted or
+     * matched, or the number of tokens if the input ended too early. 0 when
+     * accepted.
+     * @var derivation Productions applied, in order: a leftmost derivation
+     * of the input, or of the prefix read before the error. It points into
+     * the ParseStacks used and stays valid until they parse again.
+     * @var expected Terminal indices that could have been read instead of
+     * the token at error_position, EOL standing for the end of the input.
+     * Empty when accepted, and when input follows an EOL token that closed
+     * the axiom. Unlike derivation it is a copy, so it outlives the stacks.
+     */
+    struct ParseResult {
+        bool                          accepted;
+        std::size_t                   error_position;
+        std::span<const ProductionId> derivation;
+        TerminalSet                   expected;
+    };
+
+    /**
+     * @brief Working memory of Parse. Each thread parsing with the same
+     * table needs its own, made by MakeParseStacks.
+     *
+     * @var symbols The symbol stack, top at the back.
+     * @var derivation Productions applied by the last parse.
+     */
+    struct ParseStacks {
+        std::vector<SymbolId>     symbols;
+        std::vector<ProductionId> derivation;
+    };
+
     LL1Parser() = default;
     /**
      * @brief Constructs an LL1Parser with a grammar object and an input file.
@@ -61,6 +104,50 @@ class LL1Parser {
 
     void PrintTable();
 
+    /**
+     * @brief Production predicted for a non-terminal and a terminal, read
+     * from the dense table built by CreateLL1Table.
+     *
+     * @return The production, or NO_PRODUCTION if there is none.
+     */
+    ProductionId ProductionAt(SymbolId non_terminal, SymbolId terminal) const {
+        return dense_table_[gr_.st_.NonTerminalIndex(non_terminal) *
+                                table_columns_ +
+                            gr_.st_.TerminalIndex(terminal)];
+    }
+
+    /**
+     * @brief Parses a sequence of terminals with the dense LL(1) table.
+     *
+     * The symbol stack starts with the axiom; a non-terminal on top is
+     * replaced by the right-hand side of the production the table predicts
+     * for the next token, and a terminal on top has to match it. As in
+     * SLR1Parser::Parse, the EOL the axiom ends with is not part of tokens
+     * and the input ends after it.
+     *
+     * The stacks are cleared, not released, so once they have grown to the
+     * size of the inputs a parse only allocates the expected set it returns.
+     * The table is only read: threads can share a parser as long as each one
+     * has its own stacks. CreateLL1Table must have built the table, and the
+     * grammar must be LL(1): on a conflict the table keeps the first
+     * production of the cell.
+     *
+     * @param tokens SymbolIds of the terminals of the input.
+     * @param stacks Working memory, see ParseStacks.
+     */
+    ParseResult Parse(std::span<const SymbolId> tokens,
+                      ParseStacks&              stacks) const;
+
+    /// @brief Parses with the parser's own parse_stacks_, see above.
+    ParseResult Parse(std::span<const SymbolId> tokens) {
+        return Parse(tokens, parse_stacks_);
+    }
+
+    /// @brief Creates the working memory of Parse for another thread.
+    ParseStacks MakeParseStacks() const {
+        return {};
+    }
+
     /**
      * @brief Calculates the FIRST set for a given production rule in a grammar.
      *
@@ -90,15 +177,23 @@ class LL1Parser {
     void First(std::span<const std::string>     rule,
                std::unordered_set<std::string>& result);
 
+    /**
+     * @brief Calculates the FIRST set of a sequence of symbol ids, usually a
+     * right-hand side taken from the grammar's ProductionStore.
+     *
+     * @param rule The symbols whose FIRST set is computed. An empty span
+     * stands for epsilon.
+     * @param result Set where the FIRST terminals are added.
+     */
+    void First(std::span<const SymbolId> rule, TerminalSet& result) const;
+
     /**
      * @brief Computes the FIRST sets for all non-terminal symbols in the
      * grammar.
      *
-     * This function calculates the FIRST set for each non-terminal symbol in
-     * the grammar by iteratively applying a least fixed-point algorithm. This
-     * approach ensures that the FIRST sets are fully populated by repeatedly
-     * expanding and updating the sets until no further changes occur (i.e., a
-     * fixed-point is reached).
+     * The sets come from the grammar's GrammarAnalysis (see
+     * Grammar::Analysis), which is computed once per grammar and shared; this
+     * function converts them to strings and stores them in `first_sets_`.
      */
     void ComputeFirstSets();
 
@@ -112,20 +207,12 @@ class LL1Parser {
      * a derivation, the end-of-input marker (`$`) is included in its FOLLOW
      * set.
      *
-     * This function computes the FOLLOW sets using the following rules:
-     * 1. Initialize FOLLOW(S) = { $ }, where S is the start symbol.
-     * 2. For each production rule of the form A → αBβ:
-     *    - Add FIRST(β) (excluding ε) to FOLLOW(B).
-     *    - If ε ∈ FIRST(β), add FOLLOW(A) to FOLLOW(B).
-     * 3. Repeat step 2 until no changes occur in any FOLLOW set.
+     * The sets come from the grammar's GrammarAnalysis (see
+     * Grammar::Analysis), which is computed once per grammar and shared.
      *
      * The computed FOLLOW sets are cached in the `follow_sets_` member variable
      * for later use by the parser.
      *
-     * @note This function assumes that the FIRST sets for all symbols have
-     * already been computed and are available in the `first_sets_` member
-     * variable.
-     *
      * @see First
      * @see follow_sets_
      */
@@ -168,11 +255,24 @@ class LL1Parser {
      * (production body).
      * @return An unordered set of strings containing the prediction symbols for
      * the specified rule.
+     *
+     * If the rule is a production of the grammar, the result is read from
+     * the analysis' FIRST-of-suffix table instead of being computed.
      */
     std::unordered_set<std::string>
     PredictionSymbols(const std::string&              antecedent,
                       const std::vector<std::string>& consequent);
 
+    /**
+     * @brief Computes the prediction symbols of a production of the grammar's
+     * ProductionStore. Used to build the LL(1) table without going through
+     * strings.
+     *
+     * @param p Id of the production.
+     * @return The terminals that select the production.
+     */
+    TerminalSet PredictionSymbols(ProductionId p) const;
+
     std::string TeachFirst(const std::vector<std::string>& symbols);
     void TeachFirstUtil(const std::vector<std::string>&  symbols,
                         std::unordered_set<std::string>& first_set, int depth,
@@ -187,6 +287,17 @@ class LL1Parser {
     /// productions.
     ll1_table ll1_t_;
 
+    /// @brief The LL(1) table by non-terminal index (rows) and terminal
+    /// index (columns), holding the ids of the predicted productions.
+    std::vector<ProductionId> dense_table_;
+
+    /// @brief Number of columns of dense_table_, one per terminal index.
+    std::size_t table_columns_{0};
+
+    /// @brief Stacks of Parse when it is called without any, kept between
+    /// calls.
+    ParseStacks parse_stacks_;
+
     /// @brief Grammar object associated with this parser.
     Grammar gr_;
 
@@ -197,4 +308,8 @@ class LL1Parser {
     /// @brief FOLLOW sets for each non-terminal in the grammar.
     std::unordered_map<std::string, std::unordered_set<std::string>>
         follow_sets_;
+
+    /// @brief Analysis of gr_, shared with every other user of the same
+    /// grammar. first_sets_ and follow_sets_ are built from it.
+    std::shared_ptr<const GrammarAnalysis> analysis_;
 };
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "grammar.hpp"
+
 struct Lr0Item {
     std::string              antecedent_;
     std::vector<std::string> consequent_;
@@ -22,8 +26,52 @@ struct Lr0Item {
     bool        operator==(const Lr0Item& other) const;
 };
 
+/**
+ * @brief Compact LR(0) item made of a production of a ProductionStore and the
+ * position of the dot in its right-hand side.
+ *
+ * Unlike Lr0Item it owns no strings: the production is resolved against the
+ * grammar only when needed. Epsilon productions have an empty right-hand
+ * side, so their only item has the dot at 0 and is already complete.
+ */
+struct Lr0ItemRef {
+    ProductionId  production_ = 0;
+    std::uint32_t dot_        = 0;
+
+    /// @brief Symbol after the dot, or EPSILON_ID if the item is complete.
+    SymbolId NextToDot(const ProductionStore& store) const {
+        std::span<const SymbolId> rhs = store.Rhs(production_);
+        return dot_ < rhs.size() ? rhs[dot_] : SymbolTable::EPSILON_ID;
+    }
+
+    bool IsComplete(const ProductionStore& store) const {
+        return dot_ >= store.Rhs(production_).size();
+    }
+
+    /// @brief Copy of this item with the dot moved one symbol to the right.
+    Lr0ItemRef Advanced() const { return {production_, dot_ + 1}; }
+
+    bool operator==(const Lr0ItemRef& other) const = default;
+    bool operator<(const Lr0ItemRef& other) const {
+        return production_ != other.production_
+                   ? production_ < other.production_
+                   : dot_ < other.dot_;
+    }
+};
+
 namespace std {
 template <> struct hash<Lr0Item> {
     size_t operator()(const Lr0Item& item) const;
 };
+
+template <> struct hash<Lr0ItemRef> {
+    size_t operator()(const Lr0ItemRef& item) const {
+        std::uint64_t x =
+            (static_cast<std::uint64_t>(item.production_) << 32) | item.dot_;
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        return static_cast<size_t>(x);
+    }
+};
 } // namespace std
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "grammar.hpp"
+#include "lr0_item.hpp"
+#include "lr1_parser.hpp"
+#include "slr1_parser.hpp"
+#include "state.hpp"
+#include "symbol_table.hpp"
+#include "terminal_set.hpp"
+
+LR1Parser::LR1Parser(Grammar gr, Mode mode)
+    : SLR1Parser(std::move(gr)), mode_(mode) {}
+
+void LR1Parser::CloseLookaheads(const std::vector<Lr0ItemRef>& closure,
+                                std::vector<TerminalSet>&      lookaheads) const {
+    const ProductionStore& store = gr_.store_;
+    auto position = [&](const Lr0ItemRef& item) {
+        return static_cast<std::size_t>(
+            std::lower_bound(closure.begin(), closure.end(), item) -
+            closure.begin());
+    };
+
+    // An item A → α·Bβ with lookahead L gives every B → ·γ FIRST(β), plus
+    // L when β is nullable. Items are revisited while their lookahead grows.
+    std::deque<std::size_t>   pending;
+    std::vector<std::uint8_t> queued(closure.size(), 1);
+    for (std::size_t i = 0; i < closure.size(); ++i) {
+        pending.push_back(i);
+    }
+    TerminalSet spontaneous(action_columns_);
+    while (!pending.empty()) {
+        std::size_t i = pending.front();
+        pending.pop_front();
+        queued[i] = 0;
+
+        const Lr0ItemRef& item = closure[i];
+        SymbolId          next = item.NextToDot(store);
+        if (next == SymbolTable::EPSILON_ID || gr_.st_.IsTerminal(next)) {
+            continue;
+        }
+        spontaneous.Clear();
+        // The automaton shifts the axiom's EOL, so EOL is an ordinary
+        // terminal here, see GrammarAnalysis::DerivesEmpty
+        if (analysis_->LrFirst(
+                store.Rhs(item.production_).subspan(item.dot_ + 1),
+                spontaneous)) {
+            spontaneous.Merge(lookaheads[i]);
+        }
+        for (ProductionId p = store.Begin(next); p < store.End(next); ++p) {
+            std::size_t j = position({p, 0});
+            if (lookaheads[j].Merge(spontaneous) && !queued[j]) {
+                pending.push_back(j);
+                queued[j] = 1;
+            }
+        }
+    }
+}
+
+bool LR1Parser::Compatible(const std::vector<TerminalSet>& a,
+                           const std::vector<TerminalSet>& b) {
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        for (std::size_t j = i + 1; j < a.size(); ++j) {
+            bool crossed = a[i].Intersects(b[j]) || b[i].Intersects(a[j]);
+            if (crossed && !a[i].Intersects(a[j]) && !b[i].Intersects(b[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool LR1Parser::MakeParser() {
+    const ProductionStore& store   = gr_.store_;
+    const std::size_t      columns = gr_.st_.terminal_ids_.size();
+    action_columns_                = columns;
+    goto_columns_                  = gr_.st_.non_terminal_ids_.size();
+
+    // Cores, interned by kernel, with their LR(0) closure. Deques keep the
+    // closure being walked in place while new cores are added.
+    std::deque<std::vector<Lr0ItemRef>>     cores;
+    std::deque<std::vector<Lr0ItemRef>>     core_closures;
+    std::vector<std::vector<std::uint32_t>> nodes_of_core;
+    std::unordered_map<std::vector<Lr0ItemRef>, std::uint32_t, KernelHash>
+        core_ids;
+
+    std::vector<Node>         nodes;
+    std::deque<std::uint32_t> pending;
+    std::vector<std::uint8_t> queued;
+    auto enqueue = [&](std::uint32_t n) {
+        if (!queued[n]) {
+            pending.push_back(n);
+            queued[n] = 1;
+        }
+    };
+
+    // Returns the node for a kernel and its lookaheads, merging it into a
+    // compatible node of the same core in Pager mode
+    auto intern = [&](std::vector<Lr0ItemRef>  kernel,
+                      std::vector<TerminalSet> lookaheads) -> std::uint32_t {
+        auto [found, inserted] = core_ids.try_emplace(
+            kernel, static_cast<std::uint32_t>(cores.size()));
+        std::uint32_t core = found->second;
+        if (inserted) {
+            std::vector<Lr0ItemRef> closure = kernel;
+            Closure(closure);
+            cores.push_back(std::move(kernel));
+            core_closures.push_back(std::move(closure));
+            nodes_of_core.emplace_back();
+        }
+        for (std::uint32_t candidate : nodes_of_core[core]) {
+            std::vector<TerminalSet>& existing =
+                nodes[candidate].kernel_lookaheads;
+            if (existing == lookaheads) {
+                return candidate;
+            }
+            if (mode_ == Mode::Pager && Compatible(existing, lookaheads)) {
+                bool grown = false;
+                for (std::size_t i = 0; i < existing.size(); ++i) {
+                    grown |= existing[i].Merge(lookaheads[i]);
+                }
+                // Its successors have to see the new lookaheads
+                if (grown) {
+                    enqueue(candidate);
+                }
+                return candidate;
+            }
+        }
+        std::uint32_t id = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back({core, std::move(lookaheads), {}});
+        nodes_of_core[core].push_back(id);
+        queued.push_back(0);
+        enqueue(id);
+        return id;
+    };
+
+    SymbolId    axiom = gr_.st_.GetId(gr_.axiom_);
+    TerminalSet eol(columns);
+    eol.Insert(SymbolTable::EOL_INDEX);
+    intern({{store.Begin(axiom), 0}}, {eol});
+
+    std::vector<TerminalSet> lookaheads;
+    while (!pending.empty()) {
+        std::uint32_t n = pending.front();
+        pending.pop_front();
+        queued[n] = 0;
+
+        const std::vector<Lr0ItemRef>& closure = core_closures[nodes[n].core];
+        const std::vector<Lr0ItemRef>& kernel  = cores[nodes[n].core];
+        lookaheads.assign(closure.size(), TerminalSet(columns));
+        for (std::size_t k = 0; k < kernel.size(); ++k) {
+            std::size_t i =
+                std::lower_bound(closure.begin(), closure.end(), kernel[k]) -
+                closure.begin();
+            lookaheads[i] = nodes[n].kernel_lookaheads[k];
+        }
+        CloseLookaheads(closure, lookaheads);
+
+        std::vector<SymbolId> symbols;
+        for (const Lr0ItemRef& item : closure) {
+            SymbolId next = item.NextToDot(store);
+            if (next != SymbolTable::EPSILON_ID) {
+                symbols.push_back(next);
+            }
+        }
+        std::sort(symbols.begin(), symbols.end());
+        symbols.erase(std::unique(symbols.begin(), symbols.end()),
+                      symbols.end());
+
+        std::vector<std::pair<SymbolId, std::uint32_t>> gotos;
+        for (SymbolId symbol : symbols) {
+            // The kernel item (p, dot) comes from (p, dot - 1) in closure
+            std::vector<Lr0ItemRef>  next_kernel = DeltaKernel(closure, symbol);
+            std::vector<TerminalSet> next_lookaheads;
+            next_lookaheads.reserve(next_kernel.size());
+            for (const Lr0ItemRef& item : next_kernel) {
+                Lr0ItemRef  source{item.production_, item.dot_ - 1};
+                std::size_t i =
+                    std::lower_bound(closure.begin(), closure.end(), source) -
+                    closure.begin();
+                next_lookaheads.push_back(lookaheads[i]);
+            }
+            // intern may grow nodes and invalidate references into it
+            gotos.emplace_back(symbol, intern(std::move(next_kernel),
+                                              std::move(next_lookaheads)));
+        }
+        nodes[n].gotos = std::move(gotos);
+    }
+
+    // Merging may leave nodes nobody reaches any more: number the reachable
+    // ones breadth first from the initial node
+    std::vector<std::uint32_t> order{0};
+    std::vector<std::uint32_t> id_of(nodes.size(), NO_STATE);
+    id_of[0] = 0;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        for (const auto& [symbol, target] : nodes[order[i]].gotos) {
+            if (id_of[target] == NO_STATE) {
+                id_of[target] = static_cast<std::uint32_t>(order.size());
+                order.push_back(target);
+            }
+        }
+    }
+
+    states_.clear();
+    state_ids_.clear();
+    actions_.clear();
+    transitions_.clear();
+    lookaheads_.clear();
+    dense_actions_.assign(order.size() * action_columns_, EMPTY_ACTION);
+    dense_gotos_.assign(order.size() * goto_columns_, NO_STATE);
+    for (std::uint32_t id = 0; id < order.size(); ++id) {
+        const Node& node = nodes[order[id]];
+        state       st;
+        st.id_ = id;
+        st.SetKernel(cores[node.core]);
+        st.closure_ = core_closures[node.core];
+        st.items_   = ToLr0Items(st.closure_);
+        states_.push_back(std::move(st));
+
+        for (const auto& [symbol, target] : node.gotos) {
+            std::uint32_t to = id_of[target];
+            transitions_[id].insert({gr_.st_.Name(symbol), to});
+            if (gr_.st_.IsTerminal(symbol)) {
+                dense_actions_[id * action_columns_ +
+                               gr_.st_.TerminalIndex(symbol)] =
+                    PackAction(Action::Shift, to);
+            } else {
+                dense_gotos_[id * goto_columns_ +
+                             gr_.st_.NonTerminalIndex(symbol)] = to;
+            }
+        }
+
+        std::vector<TerminalSet> closed(states_[id].closure_.size(),
+                                        TerminalSet(columns));
+        for (std::size_t k = 0; k < states_[id].kernel_.size(); ++k) {
+            std::size_t i = std::lower_bound(states_[id].closure_.begin(),
+                                             states_[id].closure_.end(),
+                                             states_[id].kernel_[k]) -
+                            states_[id].closure_.begin();
+            closed[i] = node.kernel_lookaheads[k];
+        }
+        CloseLookaheads(states_[id].closure_, closed);
+        lookaheads_.push_back(std::move(closed));
+    }
+
+    // states_ is complete, so the items the actions point to stay in place
+    for (const state& st : states_) {
+        for (std::size_t i = 0; i < st.closure_.size(); ++i) {
+            if (!AddItemActions(st, st.closure_[i], lookaheads_[st.id_][i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+LR1Parser::StateReport LR1Parser::CountStates(const Grammar& gr) {
+    StateReport report{};
+    SLR1Parser  lr0(gr);
+    lr0.MakeAutomaton();
+    report.lr0 = lr0.states_.size();
+
+    LR1Parser pager(gr, Mode::Pager);
+    pager.MakeParser();
+    report.pager = pager.states_.size();
+
+    LR1Parser canonical(gr, Mode::Canonical);
+    canonical.MakeParser();
+    report.canonical = canonical.states_.size();
+    return report;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "grammar.hpp"
+#include "lr0_item.hpp"
+#include "slr1_parser.hpp"
+#include "terminal_set.hpp"
+
+/**
+ * @class LR1Parser
+ * @brief LR(1) parser, either canonical or with Pager's state merging.
+ *
+ * An LR(1) state is an LR(0) kernel (its core) plus a lookahead set for each
+ * kernel item. Cores are interned once, so states sharing a core also share
+ * its LR(0) closure, and lookaheads are TerminalSets over terminal indices.
+ *
+ * - Mode::Canonical keeps a state for every distinct kernel and lookaheads.
+ * - Mode::Pager merges a new state into an existing one with the same core
+ *   when both are weakly compatible (Pager, 1977), which never adds a
+ *   conflict the canonical automaton does not have. State counts stay close
+ *   to LALR(1).
+ *
+ * The tables have the shapes of SLR1Parser, with one entry of states_ per
+ * LR(1) state; several states may share a kernel.
+ */
+class LR1Parser : public SLR1Parser {
+  public:
+    /// @brief How states with the same core are merged.
+    enum class Mode { Canonical, Pager };
+
+    /// @brief Number of states a grammar gets with each construction.
+    struct StateReport {
+        std::size_t lr0;       ///< LR(0), SLR(1) and LALR(1).
+        std::size_t pager;     ///< LR(1) with Pager's merging.
+        std::size_t canonical; ///< Canonical LR(1).
+    };
+
+    LR1Parser() = default;
+    LR1Parser(Grammar gr, Mode mode = Mode::Canonical);
+
+    /**
+     * @brief Builds the LR(1) automaton and the action table.
+     *
+     * @return `true` if the grammar is LR(1), `false` if an action conflict
+     * remains.
+     */
+    bool MakeParser() override;
+
+    /**
+     * @brief Builds the automata of a grammar and counts their states.
+     *
+     * @param gr An augmented grammar.
+     */
+    static StateReport CountStates(const Grammar& gr);
+
+    /// @brief How states are merged, see Mode.
+    Mode mode_{Mode::Canonical};
+
+    /// @brief Lookahead of every item of each state, aligned with the
+    /// state's closure_.
+    std::vector<std::vector<TerminalSet>> lookaheads_;
+
+  private:
+    /// @brief Node of the automaton while it is being built.
+    struct Node {
+        std::uint32_t            core;
+        std::vector<TerminalSet> kernel_lookaheads;
+        /// @brief Successor of the node on each symbol.
+        std::vector<std::pair<SymbolId, std::uint32_t>> gotos;
+    };
+
+    /**
+     * @brief Completes the lookaheads of a closed item set, given those of
+     * its kernel items.
+     *
+     * @param closure A sorted LR(0) closure.
+     * @param lookaheads One set per closure item, holding on entry the
+     * kernel lookaheads.
+     */
+    void CloseLookaheads(const std::vector<Lr0ItemRef>& closure,
+                         std::vector<TerminalSet>&      lookaheads) const;
+
+    /**
+     * @brief Pager's weak compatibility of two lookahead vectors of the same
+     * core: merging them cannot create a conflict that neither had.
+     */
+    static bool Compatible(const std::vector<TerminalSet>& a,
+                           const std::vector<TerminalSet>& b);
+};
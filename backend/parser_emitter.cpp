@@ -0,0 +1,579 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "grammar.hpp"
+#include "ll1_parser.hpp"
+#include "parser_emitter.hpp"
+#include "slr1_parser.hpp"
+#include "symbol_table.hpp"
+
+namespace {
+
+/**
+ * @brief Writes the entries of an array initializer, wrapped at 80 columns,
+ * starting a new line every row entries.
+ */
+template <typename Format>
+void EmitValues(std::ostringstream&               out,
+                const std::vector<std::uint32_t>& values, std::size_t row,
+                Format&& format) {
+    std::size_t column = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        std::string text = format(values[i]) + ",";
+        if (i % row == 0 || column + 1 + text.size() > 80) {
+            out << (i == 0 ? "    " : "\n    ");
+            column = 4;
+        } else {
+            out << ' ';
+            ++column;
+        }
+        out << text;
+        column += text.size();
+    }
+    out << '\n';
+}
+
+/// @brief Formats an entry in decimal.
+std::string Decimal(std::uint32_t value) {
+    return std::to_string(value);
+}
+
+/// @brief Formats an entry in hexadecimal, which shows the packed actions.
+std::string Hexadecimal(std::uint32_t value) {
+    std::ostringstream text;
+    text << "0x" << std::hex << value;
+    return text.str();
+}
+
+/// @brief Writes a string as a C++ string literal.
+std::string Literal(const std::string& s) {
+    std::string literal = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            literal += '\\';
+        }
+        literal += c;
+    }
+    return literal + "\"";
+}
+
+/// @brief Writes a production as `A -> x y`, for comments.
+std::string ProductionText(const Grammar& gr, ProductionId p) {
+    const ProductionStore& store = gr.store_;
+    const SymbolTable&     st    = gr.st_;
+    std::string            text  = st.Name(store.Lhs(p)) + " ->";
+    if (store.Rhs(p).empty()) {
+        text += " " + st.EPSILON_;
+    }
+    for (SymbolId symbol : store.Rhs(p)) {
+        text += " " + st.Name(symbol);
+    }
+    return text;
+}
+
+/**
+ * @brief Writes what every generated parser shares: the includes, the
+ * sizes, the terminal names, FindTerminal and ParseResult, leaving
+ * namespace `name` open.
+ */
+void EmitPrelude(std::ostringstream& out, const Grammar& gr,
+                 const std::string& name) {
+    const SymbolTable& st = gr.st_;
+    out << "// Parser generated by SyntaxTutor. Do not edit.\n"
+        << "#pragma once\n"
+        << "#include <algorithm>\n"
+        << "#include <cstddef>\n"
+        << "#include <cstdint>\n"
+        << "#include <iterator>\n"
+        << "#include <string_view>\n"
+        << "#include <vector>\n\n"
+        << "namespace " << name << " {\n\n";
+
+    out << "inline constexpr std::uint32_t TERMINAL_COUNT     = "
+        << st.terminal_ids_.size() << ";\n"
+        << "inline constexpr std::uint32_t NON_TERMINAL_COUNT = "
+        << st.non_terminal_ids_.size() << ";\n"
+        << "inline constexpr std::uint32_t PRODUCTION_COUNT   = "
+        << gr.store_.Size() << ";\n\n"
+        << "/// @brief Terminal index of the end of the input.\n"
+        << "inline constexpr std::uint32_t EOL_INDEX = "
+        << SymbolTable::EOL_INDEX << ";\n\n";
+
+    out << "/// @brief Names of the terminals, by terminal index.\n"
+        << "inline constexpr std::string_view TERMINAL_NAMES[] = {\n";
+    for (SymbolId id : st.terminal_ids_) {
+        out << "    " << Literal(st.Name(id)) << ",\n";
+    }
+    out << "};\n\n";
+
+    out << R"(/// @brief Terminal index of a name, or TERMINAL_COUNT if there is none.
+constexpr std::uint32_t FindTerminal(std::string_view terminal) {
+    for (std::uint32_t i = 0; i < TERMINAL_COUNT; ++i) {
+        if (TERMINAL_NAMES[i] == terminal) {
+            return i;
+        }
+    }
+    return TERMINAL_COUNT;
+}
+
+/// @brief Outcome of Parse.
+struct ParseResult {
+    bool        accepted;
+    std::size_t error_position;
+};
+
+)";
+}
+
+/// @brief EmitPrelude, plus the number of states and IgnoreReductions of
+/// the LR parsers.
+void EmitLrPrelude(std::ostringstream& out, const SLR1Parser& parser,
+                   const std::string& name) {
+    EmitPrelude(out, parser.gr_, name);
+    out << "inline constexpr std::uint32_t STATE_COUNT = "
+        << parser.states_.size() << ";\n\n"
+        << "/// @brief Reduction callback of Parse that does nothing.\n"
+        << "struct IgnoreReductions {\n"
+        << "    constexpr void operator()(std::uint32_t) const {}\n"
+        << "};\n\n";
+}
+
+/// @brief Writes the overload of Parse that owns its state stack.
+void EmitOwnStackParse(std::ostringstream& out, const char* specifier) {
+    out << "/// @brief Parses with a state stack of its own, see above.\n"
+        << "template <typename Tokens>\n"
+        << specifier << " ParseResult Parse(const Tokens& tokens) {\n"
+        << "    std::vector<std::uint32_t> stack;\n"
+        << "    return Parse(tokens, stack);\n"
+        << "}\n\n";
+}
+
+} // namespace
+
+std::string EmitConstexprParser(const SLR1Parser& parser,
+                                const std::string& name) {
+    const ProductionStore& store = parser.gr_.store_;
+    const SymbolTable&     st    = parser.gr_.st_;
+    std::ostringstream     out;
+    EmitLrPrelude(out, parser, name);
+
+    out << "/// @brief Entry of GOTO where there is no transition.\n"
+        << "inline constexpr std::uint32_t NO_STATE = 0xffffffff;\n\n";
+
+    out << "/// @brief Productions, by id:\n";
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        out << "/// - " << p << ": " << ProductionText(parser.gr_, p)
+            << '\n';
+    }
+    std::vector<std::uint32_t> lengths;
+    std::vector<std::uint32_t> lhs;
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        lengths.push_back(static_cast<std::uint32_t>(store.Rhs(p).size()));
+        lhs.push_back(st.NonTerminalIndex(store.Lhs(p)));
+    }
+    out << "inline constexpr std::uint32_t RHS_LENGTH[] = {\n";
+    EmitValues(out, lengths, lengths.size(), Decimal);
+    out << "};\n\n"
+        << "/// @brief Non-terminal index of the left-hand side of each "
+           "production.\n"
+        << "inline constexpr std::uint32_t LHS[] = {\n";
+    EmitValues(out, lhs, lhs.size(), Decimal);
+    out << "};\n\n";
+
+    out << "/// @brief ACTION table, one row per state and one column per "
+           "terminal index:\n"
+        << "/// the kind in the top two bits (1 shift, 2 reduce, 3 accept, 0 "
+           "error) and\n"
+        << "/// the target state, or production reduced or accepted on, in "
+           "the rest.\n"
+        << "inline constexpr std::uint32_t ACTION[] = {\n";
+    EmitValues(out, parser.dense_actions_, parser.action_columns_,
+               Hexadecimal);
+    out << "};\n\n"
+        << "/// @brief GOTO table, one row per state and one column per "
+           "non-terminal index.\n"
+        << "inline constexpr std::uint32_t GOTO[] = {\n";
+    EmitValues(out, parser.dense_gotos_, parser.goto_columns_,
+               [](std::uint32_t state) {
+                   return state == SLR1Parser::NO_STATE
+                              ? std::string("NO_STATE")
+                              : Decimal(state);
+               });
+    out << "};\n\n";
+
+    out << R"(/**
+ * @brief Parses a sequence of terminal indices.
+ *
+ * The EOL the axiom ends with is not part of tokens: it is read after the
+ * last token, and the input ends there.
+ *
+ * @param tokens Random-access range of terminal indices.
+ * @param stack Vector-like container of std::uint32_t used as the state
+ * stack. It is cleared first, so it can be reused without allocating.
+ * @param on_reduce Called with the id of each production reduced by, and
+ * of the axiom production on acceptance: a rightmost derivation in reverse.
+ */
+template <typename Tokens, typename Stack,
+          typename OnReduce = IgnoreReductions>
+constexpr ParseResult Parse(const Tokens& tokens, Stack& stack,
+                            OnReduce&& on_reduce = {}) {
+    const std::size_t size     = std::size(tokens);
+    const std::size_t length   = size + 1;
+    std::size_t       position = 0;
+    stack.clear();
+    stack.push_back(0);
+    while (true) {
+        std::uint32_t token = position < size
+                                  ? static_cast<std::uint32_t>(
+                                        std::begin(tokens)[position])
+                                  : EOL_INDEX;
+        if (token >= TERMINAL_COUNT) {
+            return {false, position};
+        }
+        std::uint32_t action = ACTION[stack.back() * TERMINAL_COUNT + token];
+        std::uint32_t target = action & ((std::uint32_t{1} << 30) - 1);
+        switch (action >> 30) {
+        case 1:
+            if (position == length) {
+                return {false, size};
+            }
+            stack.push_back(target);
+            ++position;
+            break;
+        case 2:
+            stack.resize(stack.size() - RHS_LENGTH[target]);
+            stack.push_back(
+                GOTO[stack.back() * NON_TERMINAL_COUNT + LHS[target]]);
+            on_reduce(target);
+            break;
+        case 3:
+            if (position != length) {
+                return {false, position};
+            }
+            on_reduce(target);
+            return {true, 0};
+        default:
+            return {false, std::min(position, size)};
+        }
+    }
+}
+
+)";
+    EmitOwnStackParse(out, "constexpr");
+    out << "} // namespace " << name << '\n';
+    return out.str();
+}
+
+std::string EmitDirectCodedParser(const SLR1Parser& parser,
+                                  const std::string& name) {
+    using Action = SLR1Parser::Action;
+    const ProductionStore& store   = parser.gr_.store_;
+    const SymbolTable&     st      = parser.gr_.st_;
+    const std::size_t      columns = parser.action_columns_;
+    auto action = [&](std::uint32_t state, std::uint32_t terminal) {
+        return parser.dense_actions_[state * columns + terminal];
+    };
+    // States a reduction by p can go to, keyed by the state it uncovers
+    auto gotos_of = [&](ProductionId p) {
+        std::uint32_t nt = st.NonTerminalIndex(store.Lhs(p));
+        std::map<std::uint32_t, std::uint32_t> gotos;
+        for (std::uint32_t s = 0; s < parser.states_.size(); ++s) {
+            std::uint32_t to =
+                parser.dense_gotos_[s * parser.goto_columns_ + nt];
+            if (to != SLR1Parser::NO_STATE) {
+                gotos.emplace(s, to);
+            }
+        }
+        return gotos;
+    };
+
+    // Only the states and reductions reachable from state 0 get code, so
+    // that no label is left unused
+    std::set<std::uint32_t>    states{0};
+    std::set<ProductionId>     reductions;
+    std::vector<std::uint32_t> pending{0};
+    auto reach = [&](std::uint32_t state) {
+        if (states.insert(state).second) {
+            pending.push_back(state);
+        }
+    };
+    while (!pending.empty()) {
+        std::uint32_t state = pending.back();
+        pending.pop_back();
+        for (std::uint32_t terminal = 0; terminal < columns; ++terminal) {
+            SLR1Parser::PackedAction a = action(state, terminal);
+            std::uint32_t target = SLR1Parser::ActionTarget(a);
+            if (SLR1Parser::ActionKind(a) == Action::Shift) {
+                reach(target);
+            } else if (SLR1Parser::ActionKind(a) == Action::Reduce &&
+                       reductions.insert(target).second) {
+                for (const auto& [from, to] : gotos_of(target)) {
+                    reach(to);
+                }
+            }
+        }
+    }
+
+    std::ostringstream out;
+    EmitLrPrelude(out, parser, name);
+    out << R"(/// @brief Terminal index at a position, EOL past the last token.
+template <typename Tokens>
+inline std::uint32_t TokenAt(const Tokens& tokens, std::size_t position,
+                             std::size_t size) {
+    return position < size
+               ? static_cast<std::uint32_t>(std::begin(tokens)[position])
+               : EOL_INDEX;
+}
+
+/**
+ * @brief Parses a sequence of terminal indices.
+ *
+ * Every state is a label that pushes its number and switches on the
+ * lookahead: shifts jump straight to the next state, reductions pop the
+ * stack and jump on the state they uncover. The stack only holds the
+ * states to return to after a reduction.
+ *
+ * The EOL the axiom ends with is not part of tokens: it is read after the
+ * last token, and the input ends there.
+ *
+ * @param tokens Random-access range of terminal indices.
+ * @param stack Vector-like container of std::uint32_t used as the state
+ * stack. It is cleared first, so it can be reused without allocating.
+ * @param on_reduce Called with the id of each production reduced by, and
+ * of the axiom production on acceptance: a rightmost derivation in reverse.
+ */
+template <typename Tokens, typename Stack,
+          typename OnReduce = IgnoreReductions>
+ParseResult Parse(const Tokens& tokens, Stack& stack,
+                  OnReduce&& on_reduce = {}) {
+    const std::size_t size     = std::size(tokens);
+    const std::size_t length   = size + 1;
+    std::size_t       position = 0;
+    stack.clear();
+    goto state_0;
+
+)";
+
+    for (std::uint32_t state : states) {
+        out << "state_" << state << ":\n"
+            << "    stack.push_back(" << state << ");\n"
+            << "    switch (TokenAt(tokens, position, size)) {\n";
+        // Terminals with the same action share their case labels
+        std::map<SLR1Parser::PackedAction, std::vector<std::uint32_t>> cases;
+        for (std::uint32_t terminal = 0; terminal < columns; ++terminal) {
+            SLR1Parser::PackedAction a = action(state, terminal);
+            if (SLR1Parser::ActionKind(a) != Action::Empty) {
+                cases[a].push_back(terminal);
+            }
+        }
+        for (const auto& [a, terminals] : cases) {
+            std::uint32_t target = SLR1Parser::ActionTarget(a);
+            switch (SLR1Parser::ActionKind(a)) {
+            case Action::Shift:
+                for (std::uint32_t terminal : terminals) {
+                    if (terminal == SymbolTable::EOL_INDEX) {
+                        continue;
+                    }
+                    out << "    case " << terminal << ":\n";
+                }
+                if (terminals.size() > 1 ||
+                    terminals[0] != SymbolTable::EOL_INDEX) {
+                    out << "        ++position;\n"
+                        << "        goto state_" << target << ";\n";
+                }
+                // Nothing can be shifted at the end marker
+                if (terminals[0] == SymbolTable::EOL_INDEX) {
+                    out << "    case " << SymbolTable::EOL_INDEX << ":\n"
+                        << "        if (position == length) {\n"
+                        << "            return {false, size};\n"
+                        << "        }\n"
+                        << "        ++position;\n"
+                        << "        goto state_" << target << ";\n";
+                }
+                break;
+            case Action::Reduce:
+                for (std::uint32_t terminal : terminals) {
+                    out << "    case " << terminal << ":\n";
+                }
+                out << "        goto reduce_" << target << ";\n";
+                break;
+            case Action::Accept:
+                for (std::uint32_t terminal : terminals) {
+                    out << "    case " << terminal << ":\n";
+                }
+                out << "        if (position != length) {\n"
+                    << "            return {false, position};\n"
+                    << "        }\n"
+                    << "        on_reduce(" << target << ");\n"
+                    << "        return {true, 0};\n";
+                break;
+            case Action::Empty:
+                break;
+            }
+        }
+        out << "    default:\n"
+            << "        return {false, std::min(position, size)};\n"
+            << "    }\n\n";
+    }
+
+    for (ProductionId p : reductions) {
+        std::map<std::uint32_t, std::uint32_t> gotos = gotos_of(p);
+        // The most frequent target is the default of the switch
+        std::map<std::uint32_t, std::size_t> counts;
+        std::uint32_t                        common = gotos.begin()->second;
+        for (const auto& [from, to] : gotos) {
+            if (++counts[to] > counts[common]) {
+                common = to;
+            }
+        }
+        out << "reduce_" << p << ": // " << ProductionText(parser.gr_, p)
+            << '\n';
+        if (!store.Rhs(p).empty()) {
+            out << "    stack.resize(stack.size() - " << store.Rhs(p).size()
+                << ");\n";
+        }
+        out << "    on_reduce(" << p << ");\n";
+        if (counts.size() == 1) {
+            out << "    goto state_" << common << ";\n\n";
+            continue;
+        }
+        out << "    switch (stack.back()) {\n";
+        for (const auto& [from, to] : gotos) {
+            if (to != common) {
+                out << "    case " << from << ":\n"
+                    << "        goto state_" << to << ";\n";
+            }
+        }
+        out << "    default:\n"
+            << "        goto state_" << common << ";\n"
+            << "    }\n\n";
+    }
+    out << "}\n\n";
+    EmitOwnStackParse(out, "inline");
+    out << "} // namespace " << name << '\n';
+    return out.str();
+}
+
+std::string EmitRecursiveDescentParser(const LL1Parser& parser,
+                                       const std::string& name) {
+    const ProductionStore& store   = parser.gr_.store_;
+    const SymbolTable&     st      = parser.gr_.st_;
+    const std::size_t      columns = parser.table_columns_;
+    std::ostringstream     out;
+    EmitPrelude(out, parser.gr_, name);
+
+    out << R"(/// @brief Prediction callback of Parse that does nothing.
+struct IgnorePredictions {
+    constexpr void operator()(std::uint32_t) const {}
+};
+
+/// @brief Recursive-descent parser, one member function per non-terminal.
+template <typename Tokens, typename OnPredict>
+struct Parser {
+    const Tokens& tokens;
+    std::size_t   size;
+    std::size_t   position;
+    OnPredict&    on_predict;
+
+    /// @brief Terminal index of the lookahead, EOL past the last token.
+    std::uint32_t Token() const {
+        return position < size
+                   ? static_cast<std::uint32_t>(std::begin(tokens)[position])
+                   : EOL_INDEX;
+    }
+
+    /// @brief Reads the lookahead if it is `terminal`. Nothing can be read
+    /// at the end marker after the closing EOL.
+    bool Match(std::uint32_t terminal) {
+        if (Token() != terminal || position == size + 1) {
+            return false;
+        }
+        ++position;
+        return true;
+    }
+)";
+
+    // Non-terminal names need not be identifiers, so functions are numbered
+    auto function = [&](SymbolId nt) {
+        return "NonTerminal" + std::to_string(st.NonTerminalIndex(nt)) + "()";
+    };
+    for (SymbolId nt : st.non_terminal_ids_) {
+        std::uint32_t row = st.NonTerminalIndex(nt);
+        out << "\n    /// @brief " << st.Name(nt) << ".\n"
+            << "    bool " << function(nt) << " {\n"
+            << "        switch (Token()) {\n";
+        // Terminals predicting the same production share their case labels
+        std::map<ProductionId, std::vector<std::uint32_t>> cases;
+        for (std::uint32_t terminal = 0; terminal < columns; ++terminal) {
+            ProductionId p = parser.dense_table_[row * columns + terminal];
+            if (p != LL1Parser::NO_PRODUCTION) {
+                cases[p].push_back(terminal);
+            }
+        }
+        for (const auto& [p, terminals] : cases) {
+            for (std::uint32_t terminal : terminals) {
+                out << "        case " << terminal << ":\n";
+            }
+            out << "            // " << ProductionText(parser.gr_, p) << '\n'
+                << "            on_predict(" << p << ");\n";
+            // The last symbol is a tail call
+            std::span<const SymbolId> rhs = store.Rhs(p);
+            for (std::size_t i = 0; i < rhs.size(); ++i) {
+                std::string call =
+                    st.IsTerminal(rhs[i])
+                        ? "Match(" + std::to_string(st.TerminalIndex(rhs[i])) +
+                              ")"
+                        : function(rhs[i]);
+                if (i + 1 == rhs.size()) {
+                    out << "            return " << call << ";\n";
+                } else {
+                    out << "            if (!" << call << ") {\n"
+                        << "                return false;\n"
+                        << "            }\n";
+                }
+            }
+            if (rhs.empty()) {
+                out << "            return true;\n";
+            }
+        }
+        out << "        default:\n"
+            << "            return false;\n"
+            << "        }\n"
+            << "    }\n";
+    }
+    out << "};\n\n";
+
+    SymbolId axiom = st.GetId(parser.gr_.axiom_);
+    out << R"(/**
+ * @brief Parses a sequence of terminal indices.
+ *
+ * Each non-terminal is a function that switches on the lookahead and calls
+ * the functions of the predicted production, so the native stack takes the
+ * place of the symbol stack and grows with the nesting of the input. The
+ * EOL the axiom ends with is not part of tokens: it is read after the last
+ * token, and the input ends there.
+ *
+ * @param tokens Random-access range of terminal indices.
+ * @param on_predict Called with the id of each production predicted, in
+ * the order of a leftmost derivation.
+ */
+template <typename Tokens, typename OnPredict = IgnorePredictions>
+ParseResult Parse(const Tokens& tokens, OnPredict&& on_predict = {}) {
+    const std::size_t         size = std::size(tokens);
+    Parser<Tokens, OnPredict> parser{tokens, size, 0, on_predict};
+)";
+    out << "    if (!parser." << function(axiom)
+        << " || parser.position != size + 1) {\n"
+        << "        return {false, std::min(parser.position, size)};\n"
+        << "    }\n"
+        << "    return {true, 0};\n"
+        << "}\n\n"
+        << "} // namespace " << name << '\n';
+    return out.str();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <string>
+
+#include "ll1_parser.hpp"
+#include "slr1_parser.hpp"
+
+/**
+ * @brief Writes a self-contained C++ header with the parse tables of a
+ * parser, for grammars fixed at build time.
+ *
+ * The header defines, inside namespace `name`:
+ *
+ * - `ACTION` and `GOTO`, the dense tables of the parser as `constexpr`
+ *   arrays, with the same packing as SLR1Parser::PackAction.
+ * - `RHS_LENGTH` and `LHS`, the length and the non-terminal index of the
+ *   left-hand side of every production, by ProductionId.
+ * - `TERMINAL_NAMES` and `FindTerminal`, to map names to terminal indices.
+ * - `Parse`, a `constexpr` template driver over any random-access range of
+ *   terminal indices and any vector-like state stack, with the input
+ *   conventions of SLR1Parser::Parse.
+ *
+ * It only includes standard headers and needs neither Grammar nor
+ * std::string, so the tables cost nothing to set up at startup.
+ *
+ * @param parser A parser whose MakeParser succeeded. LALR1Parser and
+ * LR1Parser tables are emitted the same way.
+ * @param name Namespace of the generated code; a valid C++ identifier.
+ * @return The text of the header.
+ */
+std::string EmitConstexprParser(const SLR1Parser& parser,
+                                const std::string& name);
+
+/**
+ * @brief Writes a self-contained C++ header with a direct-coded parser:
+ * instead of tables, every state becomes a label with a switch on the
+ * lookahead, and every reduction a label with a switch on the uncovered
+ * state.
+ *
+ * Shifts and gotos are plain jumps, so the hot loop does no table lookups
+ * and each state gets branches of its own to predict. The header defines
+ * the same names as EmitConstexprParser except the tables, and its `Parse`
+ * has the same signature and results, but it is not `constexpr`.
+ *
+ * @param parser A parser whose MakeParser succeeded.
+ * @param name Namespace of the generated code; a valid C++ identifier.
+ * @return The text of the header.
+ */
+std::string EmitDirectCodedParser(const SLR1Parser& parser,
+                                  const std::string& name);
+
+/**
+ * @brief Writes a self-contained C++ header with a recursive-descent parser
+ * taken from the dense table of an LL1Parser: one function per
+ * non-terminal, switching on the lookahead and calling the symbols of the
+ * predicted production in turn.
+ *
+ * The header defines the names of EmitConstexprParser except the tables,
+ * and a `Parse(tokens, on_predict)` with the input conventions, the
+ * results and the derivation of LL1Parser::Parse, without the expected
+ * terminals.
+ *
+ * @param parser A parser whose CreateLL1Table succeeded.
+ * @param name Namespace of the generated code; a valid C++ identifier.
+ * @return The text of the header.
+ */
+std::string EmitRecursiveDescentParser(const LL1Parser& parser,
+                                       const std::string& name);
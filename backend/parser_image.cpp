@@ -0,0 +1,571 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "grammar.hpp"
+#include "grammar_analysis.hpp"
+#include "ll1_parser.hpp"
+#include "parser_image.hpp"
+#include "slr1_parser.hpp"
+#include "state.hpp"
+#include "symbol_table.hpp"
+
+namespace {
+
+/// @brief Appends production `lhs -> rhs` to a canonical text, leaving out
+/// EPSILON so that an empty right-hand side reads the same either way.
+template <typename Names>
+void AppendRule(std::string& text, std::string_view lhs, const Names& rhs) {
+    text += lhs;
+    text += " ->";
+    for (std::string_view symbol : rhs) {
+        if (symbol != "EPSILON") {
+            text += ' ';
+            text += symbol;
+        }
+    }
+    text += '\n';
+}
+
+/// @brief Canonical text of the rules of a grammar, see ParserImage::Hash.
+std::string CanonicalRules(const Grammar& gr) {
+    std::vector<const std::string*> antecedents;
+    for (const auto& [nt, prods] : gr.g_) {
+        antecedents.push_back(&nt);
+    }
+    std::sort(antecedents.begin(), antecedents.end(),
+              [](const std::string* a, const std::string* b) {
+                  return *a < *b;
+              });
+    std::string text;
+    for (const std::string* nt : antecedents) {
+        for (const production& prod : gr.g_.at(*nt)) {
+            AppendRule(text, *nt, prod);
+        }
+    }
+    return text;
+}
+
+/// @brief The same text from an image, whose productions are sorted by
+/// antecedent id and in the order they were written.
+std::string CanonicalRules(const ParserImage& image) {
+    const ParserImage::Header& header = image.GetHeader();
+    // First production of each antecedent, S' left out
+    std::vector<ProductionId> starts;
+    for (ProductionId p = 0; p < header.productions; ++p) {
+        if (image.Lhs(p) != header.augmented_axiom &&
+            (starts.empty() || image.Lhs(starts.back()) != image.Lhs(p))) {
+            starts.push_back(p);
+        }
+    }
+    std::sort(starts.begin(), starts.end(),
+              [&](ProductionId a, ProductionId b) {
+                  return image.Name(image.Lhs(a)) < image.Name(image.Lhs(b));
+              });
+    std::string                   text;
+    std::vector<std::string_view> rhs;
+    for (ProductionId start : starts) {
+        SymbolId nt = image.Lhs(start);
+        for (ProductionId p = start;
+             p < header.productions && image.Lhs(p) == nt; ++p) {
+            rhs.clear();
+            for (SymbolId symbol : image.Rhs(p)) {
+                rhs.push_back(image.Name(symbol));
+            }
+            AppendRule(text, image.Name(nt), rhs);
+        }
+    }
+    return text;
+}
+
+/// @brief FNV-1a, 64 bits.
+std::uint64_t Fnv1a(std::string_view text) {
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+/// @brief Checksum of an image: FNV-1a of the bytes after its header.
+std::uint64_t Checksum(std::span<const std::byte> image) {
+    return Fnv1a({reinterpret_cast<const char*>(image.data()) +
+                      sizeof(ParserImage::Header),
+                  image.size() - sizeof(ParserImage::Header)});
+}
+
+/// @brief Lays out the sections of an image, each at an 8-byte boundary.
+class ImageWriter {
+  public:
+    ImageWriter() : bytes_(sizeof(ParserImage::Header)) {}
+
+    template <typename T>
+    void Write(ParserImage::Section section, std::span<const T> values) {
+        bytes_.resize((bytes_.size() + 7) / 8 * 8);
+        header_.sections[section] = {bytes_.size(), values.size_bytes()};
+        const std::byte* data =
+            reinterpret_cast<const std::byte*>(values.data());
+        bytes_.insert(bytes_.end(), data, data + values.size_bytes());
+    }
+
+    std::vector<std::byte> Finish() {
+        header_.size     = bytes_.size();
+        header_.checksum = Checksum(bytes_);
+        std::memcpy(bytes_.data(), &header_, sizeof(header_));
+        return std::move(bytes_);
+    }
+
+    ParserImage::Header header_{};
+
+  private:
+    std::vector<std::byte> bytes_;
+};
+
+} // namespace
+
+std::vector<std::byte> ParserImage::Build(const Grammar& gr) {
+    LL1Parser ll1(gr);
+    bool      is_ll1    = ll1.CreateLL1Table();
+    Grammar   augmented = gr;
+    augmented.TransformToAugmentedGrammar();
+    SLR1Parser slr1(augmented);
+    bool       is_slr1 = slr1.MakeParser();
+
+    const SymbolTable&     st       = augmented.st_;
+    const ProductionStore& store    = augmented.store_;
+    const GrammarAnalysis& analysis = *augmented.Analysis();
+    const std::uint32_t    symbols  = static_cast<std::uint32_t>(st.Size());
+    const std::uint32_t    terminals =
+        static_cast<std::uint32_t>(st.terminal_ids_.size());
+    const std::uint32_t non_terminals =
+        static_cast<std::uint32_t>(st.non_terminal_ids_.size());
+    const std::uint32_t states =
+        static_cast<std::uint32_t>(slr1.states_.size());
+    const std::uint32_t set_words = (terminals + 63) / 64;
+
+    ImageWriter writer;
+    Header&     header     = writer.header_;
+    header.magic           = MAGIC;
+    header.version         = VERSION;
+    header.grammar_hash    = Hash(gr);
+    header.flags           = (is_ll1 ? IS_LL1 : 0) | (is_slr1 ? IS_SLR1 : 0);
+    header.symbols         = symbols;
+    header.terminals       = terminals;
+    header.non_terminals   = non_terminals;
+    header.productions     = static_cast<std::uint32_t>(store.Size());
+    header.states          = states;
+    header.set_words       = set_words;
+    header.axiom           = st.GetId(gr.axiom_);
+    header.augmented_axiom = st.GetId(augmented.axiom_);
+
+    std::vector<std::uint32_t> name_offsets{0};
+    std::string                names;
+    std::vector<std::uint32_t> name_order(symbols);
+    std::vector<std::uint32_t> kinds(symbols);
+    for (SymbolId id = 0; id < symbols; ++id) {
+        names += st.Name(id);
+        name_offsets.push_back(static_cast<std::uint32_t>(names.size()));
+        name_order[id] = id;
+        kinds[id] = st.kind_index_[id] << 1 | (st.IsTerminal(id) ? 1 : 0);
+    }
+    std::sort(name_order.begin(), name_order.end(),
+              [&](SymbolId a, SymbolId b) { return st.Name(a) < st.Name(b); });
+    writer.Write<std::uint32_t>(NAME_OFFSETS, name_offsets);
+    writer.Write<char>(NAMES, names);
+    writer.Write<std::uint32_t>(NAME_ORDER, name_order);
+    writer.Write<std::uint32_t>(KINDS, kinds);
+
+    writer.Write<std::uint32_t>(LHS, store.lhs_);
+    writer.Write<std::uint32_t>(RHS_OFFSETS, store.offsets_);
+    writer.Write<std::uint32_t>(RHS, store.symbols_);
+
+    std::vector<std::uint64_t> first(std::size_t{symbols} * set_words);
+    std::vector<std::uint64_t> follow(first.size());
+    for (SymbolId id = 0; id < symbols; ++id) {
+        std::uint64_t* first_words  = &first[id * set_words];
+        std::uint64_t* follow_words = &follow[id * set_words];
+        analysis.First(id).ForEach([&](std::uint32_t t) {
+            first_words[t / 64] |= std::uint64_t{1} << (t % 64);
+        });
+        analysis.Follow(id).ForEach([&](std::uint32_t t) {
+            follow_words[t / 64] |= std::uint64_t{1} << (t % 64);
+        });
+    }
+    writer.Write<std::uint64_t>(FIRST, first);
+    writer.Write<std::uint64_t>(FOLLOW, follow);
+
+    std::vector<std::uint32_t> kernel_offsets{0};
+    std::vector<KernelItem>    kernel_items;
+    for (const state& lr0 : slr1.states_) {
+        for (const Lr0ItemRef& item : lr0.kernel_) {
+            kernel_items.push_back({item.production_, item.dot_});
+        }
+        kernel_offsets.push_back(
+            static_cast<std::uint32_t>(kernel_items.size()));
+    }
+    writer.Write<std::uint32_t>(KERNEL_OFFSETS, kernel_offsets);
+    writer.Write<KernelItem>(KERNEL_ITEMS, kernel_items);
+    writer.Write<std::uint32_t>(ACTION, slr1.dense_actions_);
+    writer.Write<std::uint32_t>(GOTO, slr1.dense_gotos_);
+
+    // The LL(1) grammar lacks S', whose non-terminal index comes last
+    std::vector<std::uint32_t> ll1_table = ll1.dense_table_;
+    ll1_table.resize(std::size_t{non_terminals} * terminals, NONE);
+    writer.Write<std::uint32_t>(LL1_TABLE, ll1_table);
+    return writer.Finish();
+}
+
+std::uint64_t ParserImage::Hash(const Grammar& gr) {
+    return Fnv1a(CanonicalRules(gr));
+}
+
+std::shared_ptr<const ParserImage>
+ParserImage::Open(const std::filesystem::path& path) {
+    std::shared_ptr<ParserImage> image(new ParserImage());
+#if !defined(_WIN32)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    std::size_t size    = static_cast<std::size_t>(info.st_size);
+    void*       mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    image->mapping_      = mapping;
+    image->mapping_size_ = size;
+    image->Validate({static_cast<const std::byte*>(mapping), size});
+#else
+    // No mapping here: the file is read into memory
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return nullptr;
+    }
+    image->owned_.assign(std::istreambuf_iterator<char>(in), {});
+    image->Validate(image->owned_);
+#endif
+    return image->Valid() ? image : nullptr;
+}
+
+ParserImage::ParserImage(std::span<const std::byte> bytes) {
+    Validate(bytes);
+}
+
+ParserImage::ParserImage(std::vector<std::byte> bytes)
+    : owned_(std::move(bytes)) {
+    Validate(owned_);
+}
+
+ParserImage::~ParserImage() {
+#if !defined(_WIN32)
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_size_);
+    }
+#endif
+}
+
+void ParserImage::Validate(std::span<const std::byte> bytes) {
+    header_ = nullptr;
+    bytes_  = bytes;
+    if (bytes.size() < sizeof(Header) ||
+        reinterpret_cast<std::uintptr_t>(bytes.data()) % 8 != 0) {
+        return;
+    }
+    const Header* header = reinterpret_cast<const Header*>(bytes.data());
+    if (header->magic != MAGIC || header->version != VERSION ||
+        header->size != bytes.size() || header->checksum != Checksum(bytes)) {
+        return;
+    }
+    for (const SectionEntry& section : header->sections) {
+        if (section.offset % 8 != 0 || section.offset > bytes.size() ||
+            section.size > bytes.size() - section.offset) {
+            return;
+        }
+    }
+
+    // The checksum catches a damaged file. An image made on purpose can
+    // still pass it, so the shapes are checked, then every offset and id,
+    // and no accessor can read outside the image
+    auto words = [&](Section s) {
+        return header->sections[s].size / sizeof(std::uint32_t);
+    };
+    auto values = [&](Section s) {
+        return std::span<const std::uint32_t>(
+            reinterpret_cast<const std::uint32_t*>(
+                bytes.data() + header->sections[s].offset),
+            words(s));
+    };
+    auto last = [&](Section s) {
+        return words(s) == 0 ? std::uint64_t{0} : values(s).back();
+    };
+    const std::uint64_t symbols       = header->symbols;
+    const std::uint64_t terminals     = header->terminals;
+    const std::uint64_t non_terminals = header->non_terminals;
+    const std::uint64_t productions   = header->productions;
+    const std::uint64_t states        = header->states;
+    const std::uint64_t set_size      = symbols * header->set_words * 8;
+    bool                valid =
+        header->set_words == (terminals + 63) / 64 &&
+        terminals + non_terminals == symbols && states > 0 &&
+        header->axiom < symbols && header->augmented_axiom < symbols &&
+        words(NAME_OFFSETS) == symbols + 1 &&
+        header->sections[NAMES].size == last(NAME_OFFSETS) &&
+        words(NAME_ORDER) == symbols && words(KINDS) == symbols &&
+        words(LHS) == productions && words(RHS_OFFSETS) == productions + 1 &&
+        words(RHS) == last(RHS_OFFSETS) &&
+        header->sections[FIRST].size == set_size &&
+        header->sections[FOLLOW].size == set_size &&
+        words(KERNEL_OFFSETS) == states + 1 &&
+        header->sections[KERNEL_ITEMS].size ==
+            last(KERNEL_OFFSETS) * sizeof(KernelItem) &&
+        words(ACTION) == states * terminals &&
+        words(GOTO) == states * non_terminals &&
+        words(LL1_TABLE) == non_terminals * terminals;
+    if (!valid) {
+        return;
+    }
+
+    // Offsets start at 0 and never decrease; the last one was checked above
+    auto ascending = [&](Section s) {
+        std::span<const std::uint32_t> offsets = values(s);
+        return offsets.front() == 0 &&
+               std::is_sorted(offsets.begin(), offsets.end());
+    };
+    auto all_of = [&](Section s, auto&& predicate) {
+        std::span<const std::uint32_t> entries = values(s);
+        return std::all_of(entries.begin(), entries.end(), predicate);
+    };
+    auto is_symbol = [&](std::uint32_t id) { return id < symbols; };
+    std::span<const std::uint32_t> kinds       = values(KINDS);
+    std::span<const std::uint32_t> rhs_offsets = values(RHS_OFFSETS);
+    std::span<const KernelItem>    kernel_items(
+        reinterpret_cast<const KernelItem*>(
+            bytes.data() + header->sections[KERNEL_ITEMS].offset),
+        last(KERNEL_OFFSETS));
+    valid =
+        ascending(NAME_OFFSETS) && ascending(RHS_OFFSETS) &&
+        ascending(KERNEL_OFFSETS) && all_of(NAME_ORDER, is_symbol) &&
+        all_of(RHS, is_symbol) &&
+        all_of(KINDS,
+               [&](std::uint32_t kind) {
+                   return (kind >> 1) < (kind & 1 ? terminals : non_terminals);
+               }) &&
+        all_of(LHS,
+               [&](std::uint32_t id) {
+                   return id < symbols && (kinds[id] & 1) == 0;
+               }) &&
+        std::all_of(kernel_items.begin(), kernel_items.end(),
+                    [&](const KernelItem& item) {
+                        return item.production < productions &&
+                               item.dot <= rhs_offsets[item.production + 1] -
+                                               rhs_offsets[item.production];
+                    }) &&
+        all_of(ACTION,
+               [&](std::uint32_t action) {
+                   std::uint32_t target = SLR1Parser::ActionTarget(action);
+                   switch (SLR1Parser::ActionKind(action)) {
+                   case SLR1Parser::Action::Shift:
+                       return target < states;
+                   case SLR1Parser::Action::Reduce:
+                   case SLR1Parser::Action::Accept:
+                       return target < productions;
+                   default:
+                       return true;
+                   }
+               }) &&
+        all_of(GOTO,
+               [&](std::uint32_t to) { return to < states || to == NONE; }) &&
+        all_of(LL1_TABLE, [&](std::uint32_t p) {
+            return p < productions || p == NONE;
+        });
+    if (valid) {
+        header_ = header;
+    }
+}
+
+bool ParserImage::Matches(const Grammar& gr) const {
+    return CanonicalRules(*this) == CanonicalRules(gr);
+}
+
+std::string_view ParserImage::Name(SymbolId id) const {
+    const std::uint32_t* offsets = Array<std::uint32_t>(NAME_OFFSETS);
+    return {Array<char>(NAMES) + offsets[id], offsets[id + 1] - offsets[id]};
+}
+
+SymbolId ParserImage::GetId(std::string_view name) const {
+    const std::uint32_t* order = Array<std::uint32_t>(NAME_ORDER);
+    const std::uint32_t* found = std::lower_bound(
+        order, order + header_->symbols, name,
+        [&](SymbolId id, std::string_view key) { return Name(id) < key; });
+    return found != order + header_->symbols && Name(*found) == name
+               ? *found
+               : SymbolTable::NO_SYMBOL;
+}
+
+std::span<const SymbolId> ParserImage::Rhs(ProductionId p) const {
+    const std::uint32_t* offsets = Array<std::uint32_t>(RHS_OFFSETS);
+    return {Array<SymbolId>(RHS) + offsets[p], offsets[p + 1] - offsets[p]};
+}
+
+std::span<const ParserImage::KernelItem>
+ParserImage::Kernel(std::uint32_t state) const {
+    const std::uint32_t* offsets = Array<std::uint32_t>(KERNEL_OFFSETS);
+    return {Array<KernelItem>(KERNEL_ITEMS) + offsets[state],
+            offsets[state + 1] - offsets[state]};
+}
+
+ParserImage::ParseResult
+ParserImage::ParseSLR1(std::span<const SymbolId>   tokens,
+                       std::vector<std::uint32_t>& stack) const {
+    using Action = SLR1Parser::Action;
+    stack.clear();
+    stack.push_back(0);
+    const std::size_t length   = tokens.size() + 1;
+    std::size_t       position = 0;
+    while (true) {
+        SymbolId token =
+            position < tokens.size() ? tokens[position] : SymbolTable::EOL_ID;
+        if (token >= header_->symbols || !IsTerminal(token)) {
+            return {false, position};
+        }
+        std::uint32_t action = ActionAt(stack.back(), KindIndex(token));
+        std::uint32_t target = SLR1Parser::ActionTarget(action);
+        switch (SLR1Parser::ActionKind(action)) {
+        case Action::Shift:
+            if (position == length) {
+                return {false, tokens.size()};
+            }
+            stack.push_back(target);
+            ++position;
+            break;
+        case Action::Reduce: {
+            // Validate checked the entries one by one, not that they form a
+            // parser, so a reduction could still pop too much or miss a goto
+            std::size_t popped = Rhs(target).size();
+            if (popped >= stack.size()) {
+                return {false, std::min(position, tokens.size())};
+            }
+            stack.resize(stack.size() - popped);
+            std::uint32_t to = GotoAt(stack.back(), KindIndex(Lhs(target)));
+            if (to == NONE) {
+                return {false, std::min(position, tokens.size())};
+            }
+            stack.push_back(to);
+            break;
+        }
+        case Action::Accept:
+            if (position != length) {
+                return {false, position};
+            }
+            return {true, 0};
+        case Action::Empty:
+            return {false, std::min(position, tokens.size())};
+        }
+    }
+}
+
+ParserImage::ParseResult
+ParserImage::ParseLL1(std::span<const SymbolId> tokens,
+                      std::vector<SymbolId>&    stack) const {
+    stack.clear();
+    stack.push_back(header_->axiom);
+    const std::size_t length   = tokens.size() + 1;
+    std::size_t       position = 0;
+    while (!stack.empty()) {
+        SymbolId token =
+            position < tokens.size() ? tokens[position] : SymbolTable::EOL_ID;
+        if (token >= header_->symbols || !IsTerminal(token)) {
+            return {false, std::min(position, tokens.size())};
+        }
+        SymbolId top = stack.back();
+        if (IsTerminal(top)) {
+            if (top != token || position == length) {
+                return {false, std::min(position, tokens.size())};
+            }
+            stack.pop_back();
+            ++position;
+            continue;
+        }
+        ProductionId p = ProductionAt(KindIndex(top), KindIndex(token));
+        if (p == NONE) {
+            return {false, std::min(position, tokens.size())};
+        }
+        stack.pop_back();
+        std::span<const SymbolId> rhs = Rhs(p);
+        stack.insert(stack.end(), rhs.rbegin(), rhs.rend());
+    }
+    if (position != length) {
+        return {false, std::min(position, tokens.size())};
+    }
+    return {true, 0};
+}
+
+ParserCache::ParserCache(std::filesystem::path directory)
+    : directory_(std::move(directory)) {}
+
+std::filesystem::path ParserCache::PathOf(std::uint64_t hash) const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << hash << ".stpi";
+    return directory_ / name.str();
+}
+
+std::shared_ptr<const ParserImage> ParserCache::Load(const Grammar& gr) const {
+    std::uint64_t                      hash  = ParserImage::Hash(gr);
+    std::filesystem::path              path  = PathOf(hash);
+    std::shared_ptr<const ParserImage> image = ParserImage::Open(path);
+    if (image && image->GetHeader().grammar_hash == hash &&
+        image->Matches(gr)) {
+        return image;
+    }
+
+    std::vector<std::byte> bytes = ParserImage::Build(gr);
+    // Written under a name of its own and renamed, which replaces the file
+    // at once for concurrent readers and writers
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    std::filesystem::path temporary = path;
+    temporary += "." + std::to_string(std::random_device{}()) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()),
+                  static_cast<std::streamsize>(bytes.size()));
+        ec = out ? std::error_code{}
+                 : std::make_error_code(std::errc::io_error);
+    }
+    if (!ec) {
+        std::filesystem::rename(temporary, path, ec);
+    }
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+    } else if ((image = ParserImage::Open(path))) {
+        return image;
+    }
+    return std::make_shared<const ParserImage>(std::move(bytes));
+}
@@ -0,0 +1,283 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "grammar.hpp"
+#include "symbol_table.hpp"
+
+/**
+ * @class ParserImage
+ * @brief Read-only view of a grammar and its built parsers, stored in one
+ * binary blob that is used in place.
+ *
+ * An image holds the symbol table, the productions, FIRST and FOLLOW, the
+ * kernels of the LR(0) states, the SLR(1) ACTION/GOTO tables and the LL(1)
+ * table of a grammar, as built by SLR1Parser (on the augmented grammar) and
+ * LL1Parser. Every part is a flat array at an 8-byte aligned offset, so a
+ * file mapped with Open is usable as soon as it is mapped: the accessors
+ * return spans into the mapping, and ParseSLR1/ParseLL1 run on it directly.
+ *
+ * The layout is a Header followed by the sections listed in Section, all in
+ * the byte order of the machine that wrote it. Open and the constructors
+ * reject blobs with another magic number, version or checksum, whose
+ * sections do not fit, or with an offset or id out of range, so a stale,
+ * foreign or corrupt file is rebuilt rather than misread.
+ *
+ * Symbol and production ids are those of the augmented grammar, which has
+ * the ids of the grammar it was made from plus S' and S' → S last. An image
+ * from ParserCache may have been built from the same rules with other ids,
+ * so tokens are mapped with GetId by name.
+ */
+class ParserImage {
+  public:
+    /// @brief "STPI" read as a little-endian word.
+    static constexpr std::uint32_t MAGIC = 0x49505453;
+    /// @brief Incremented on every change of the layout.
+    static constexpr std::uint32_t VERSION = 1;
+
+    /// @brief Header flags.
+    static constexpr std::uint32_t IS_LL1  = 1;
+    static constexpr std::uint32_t IS_SLR1 = 2;
+
+    /// @brief Entry of the LL(1) table without a production, and of GOTO
+    /// without a state.
+    static constexpr std::uint32_t NONE = 0xffffffff;
+
+    /// @brief Sections of an image, in the order they are laid out.
+    enum Section : std::uint32_t {
+        NAME_OFFSETS,   ///< u32[symbols + 1], into NAMES.
+        NAMES,          ///< Characters of every name, concatenated.
+        NAME_ORDER,     ///< u32[symbols], the ids sorted by name.
+        KINDS,          ///< u32[symbols], kind index << 1 | is terminal.
+        LHS,            ///< u32[productions].
+        RHS_OFFSETS,    ///< u32[productions + 1], into RHS.
+        RHS,            ///< u32, the right-hand sides concatenated.
+        FIRST,          ///< u64[symbols * set_words], FIRST bitsets.
+        FOLLOW,         ///< u64[symbols * set_words], FOLLOW bitsets.
+        KERNEL_OFFSETS, ///< u32[states + 1], into KERNEL_ITEMS.
+        KERNEL_ITEMS,   ///< KernelItem, the state kernels concatenated.
+        ACTION,         ///< u32[states * terminals], packed actions.
+        GOTO,           ///< u32[states * non_terminals].
+        LL1_TABLE,      ///< u32[non_terminals * terminals].
+        SECTION_COUNT
+    };
+
+    /// @brief Offset and size in bytes of a section.
+    struct SectionEntry {
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    /// @brief First bytes of an image.
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t grammar_hash;
+        std::uint64_t size;
+        /// @brief FNV-1a of the bytes after the header.
+        std::uint64_t checksum;
+        std::uint32_t flags;
+        std::uint32_t symbols;
+        std::uint32_t terminals;
+        std::uint32_t non_terminals;
+        std::uint32_t productions;
+        std::uint32_t states;
+        /// @brief Words of each FIRST and FOLLOW bitset.
+        std::uint32_t set_words;
+        /// @brief S, the axiom of LL(1) parsing.
+        std::uint32_t axiom;
+        /// @brief S', the axiom of the augmented grammar.
+        std::uint32_t augmented_axiom;
+        std::uint32_t reserved;
+        SectionEntry  sections[SECTION_COUNT];
+    };
+
+    /// @brief An LR(0) kernel item, as Lr0ItemRef.
+    struct KernelItem {
+        std::uint32_t production;
+        std::uint32_t dot;
+    };
+
+    /// @brief Outcome of ParseSLR1 and ParseLL1, with the meaning of
+    /// SLR1Parser::ParseResult.
+    struct ParseResult {
+        bool        accepted;
+        std::size_t error_position;
+    };
+
+    /**
+     * @brief Builds the parsers of a grammar and writes their image.
+     *
+     * @param gr A grammar as made by its constructor, not augmented.
+     */
+    static std::vector<std::byte> Build(const Grammar& gr);
+
+    /**
+     * @brief Hash of the rules of a grammar, independent of the ids its
+     * symbols got: antecedents sorted by name, each with its alternatives
+     * in the order they were written.
+     */
+    static std::uint64_t Hash(const Grammar& gr);
+
+    /**
+     * @brief Maps an image file read-only.
+     *
+     * @return The image, or nullptr if the file cannot be mapped or is not
+     * a valid image.
+     */
+    static std::shared_ptr<const ParserImage>
+    Open(const std::filesystem::path& path);
+
+    /// @brief Image over bytes owned by the caller, which must outlive it.
+    explicit ParserImage(std::span<const std::byte> bytes);
+
+    /// @brief Image owning its bytes, e.g. the result of Build.
+    explicit ParserImage(std::vector<std::byte> bytes);
+
+    ParserImage(const ParserImage&)            = delete;
+    ParserImage& operator=(const ParserImage&) = delete;
+    ~ParserImage();
+
+    /// @brief Whether the bytes hold an image this version can read. Every
+    /// other accessor requires it.
+    bool Valid() const { return header_ != nullptr; }
+
+    /// @brief Whether the image holds the rules of gr, see Hash.
+    bool Matches(const Grammar& gr) const;
+
+    const Header& GetHeader() const { return *header_; }
+    bool          IsLL1() const { return header_->flags & IS_LL1; }
+    bool          IsSLR1() const { return header_->flags & IS_SLR1; }
+
+    std::string_view Name(SymbolId id) const;
+
+    /// @brief Id of a symbol by name, or SymbolTable::NO_SYMBOL.
+    SymbolId GetId(std::string_view name) const;
+
+    bool IsTerminal(SymbolId id) const {
+        return Array<std::uint32_t>(KINDS)[id] & 1;
+    }
+
+    /// @brief Index of a symbol among the terminals or the non-terminals.
+    std::uint32_t KindIndex(SymbolId id) const {
+        return Array<std::uint32_t>(KINDS)[id] >> 1;
+    }
+
+    SymbolId Lhs(ProductionId p) const { return Array<std::uint32_t>(LHS)[p]; }
+
+    /// @brief Right-hand side of production p, empty for epsilon.
+    std::span<const SymbolId> Rhs(ProductionId p) const;
+
+    /// @brief Whether FIRST of a symbol contains a terminal index.
+    bool FirstContains(SymbolId id, std::uint32_t terminal) const {
+        return SetContains(FIRST, id, terminal);
+    }
+
+    /// @brief Whether FOLLOW of a symbol contains a terminal index.
+    bool FollowContains(SymbolId id, std::uint32_t terminal) const {
+        return SetContains(FOLLOW, id, terminal);
+    }
+
+    /// @brief Kernel of an LR(0) state, sorted as in state::kernel_.
+    std::span<const KernelItem> Kernel(std::uint32_t state) const;
+
+    /// @brief Packed action, see SLR1Parser::PackAction.
+    std::uint32_t ActionAt(std::uint32_t state, std::uint32_t terminal) const {
+        return Array<std::uint32_t>(ACTION)[state * header_->terminals +
+                                            terminal];
+    }
+
+    /// @brief Target of a goto, or NONE.
+    std::uint32_t GotoAt(std::uint32_t state,
+                         std::uint32_t non_terminal) const {
+        return Array<std::uint32_t>(GOTO)[state * header_->non_terminals +
+                                          non_terminal];
+    }
+
+    /// @brief Production of the LL(1) table, or NONE.
+    std::uint32_t ProductionAt(std::uint32_t non_terminal,
+                               std::uint32_t terminal) const {
+        return Array<std::uint32_t>(LL1_TABLE)[non_terminal *
+                                                   header_->terminals +
+                                               terminal];
+    }
+
+    /**
+     * @brief Parses tokens with the SLR(1) tables, as SLR1Parser::Parse.
+     *
+     * @param tokens SymbolIds of the image.
+     * @param stack State stack, cleared first.
+     */
+    ParseResult ParseSLR1(std::span<const SymbolId>   tokens,
+                          std::vector<std::uint32_t>& stack) const;
+
+    /**
+     * @brief Parses tokens with the LL(1) table, as LL1Parser::Parse.
+     *
+     * @param tokens SymbolIds of the image.
+     * @param stack Symbol stack, cleared first.
+     */
+    ParseResult ParseLL1(std::span<const SymbolId> tokens,
+                         std::vector<SymbolId>&    stack) const;
+
+  private:
+    ParserImage() = default;
+
+    /// @brief Checks the header, the checksum and every offset and id in
+    /// the sections, setting header_ if the bytes are a valid image.
+    void Validate(std::span<const std::byte> bytes);
+
+    template <typename T> const T* Array(Section section) const {
+        return reinterpret_cast<const T*>(
+            bytes_.data() + header_->sections[section].offset);
+    }
+
+    bool SetContains(Section section, SymbolId id,
+                     std::uint32_t terminal) const {
+        const std::uint64_t* set =
+            Array<std::uint64_t>(section) + id * header_->set_words;
+        return (set[terminal / 64] >> (terminal % 64)) & 1;
+    }
+
+    const Header*              header_{nullptr};
+    std::span<const std::byte> bytes_;
+    std::vector<std::byte>     owned_;
+    /// @brief Mapping made by Open, released by the destructor.
+    void*       mapping_{nullptr};
+    std::size_t mapping_size_{0};
+};
+
+/**
+ * @class ParserCache
+ * @brief Directory of parser images keyed by ParserImage::Hash, so a grammar
+ * built once is mapped instead of rebuilt on later runs.
+ *
+ * Files are written to a temporary name and renamed into place, so a reader
+ * never maps a partial image. An image that is missing, invalid, of another
+ * version or of other rules (a hash collision) is rebuilt and replaced.
+ */
+class ParserCache {
+  public:
+    explicit ParserCache(std::filesystem::path directory);
+
+    /**
+     * @brief Image of a grammar: mapped from the cache if it is there,
+     * built and stored otherwise.
+     *
+     * @param gr A grammar as made by its constructor, not augmented.
+     * @return The image. If the directory cannot be written, it is built
+     * in memory and nothing is stored.
+     */
+    std::shared_ptr<const ParserImage> Load(const Grammar& gr) const;
+
+    /// @brief File of the image with a given hash.
+    std::filesystem::path PathOf(std::uint64_t hash) const;
+
+    std::filesystem::path directory_;
+};
@@ -1,19 +1,27 @@
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <map>
-#include <queue>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "bitset.hpp"
+#include "digraph.hpp"
 #include "grammar.hpp"
+#include "grammar_analysis.hpp"
 #include "slr1_parser.hpp"
 #include "symbol_table.hpp"
 #include "tabulate.hpp"
+#include "terminal_set.hpp"
 
 SLR1Parser::SLR1Parser(Grammar gr) : gr_(std::move(gr)) {
     ComputeFirstSets();
     ComputeFollowSets();
+    BuildClosureTables();
 }
 
 std::unordered_set<Lr0Item> SLR1Parser::AllItems() const {
@@ -35,12 +43,9 @@ void SLR1Parser::DebugStates() const {
 
     for (size_t state = 0; state < states_.size(); ++state) {
         tabulate::Table::Row_t row;
-        const auto             currentIt = std::find_if(
-            states_.begin(), states_.end(),
-            [state](const auto& st) -> bool { return st.id_ == state; });
         row.push_back(std::to_string(state));
         std::string str = "";
-        for (const auto& item : currentIt->items_) {
+        for (const auto& item : states_[state].items_) {
             str += item.ToString();
             str += "\n";
         }
@@ -159,128 +164,149 @@ void SLR1Parser::DebugActions() {
 
 void SLR1Parser::MakeInitialState() {
     state initial;
-    initial.id_ = 0;
-    auto axiom  = gr_.g_.at(gr_.axiom_);
+    initial.id_    = 0;
+    SymbolId axiom = gr_.st_.GetId(gr_.axiom_);
     // the axiom must be unique
-    initial.items_.insert(
-        {gr_.axiom_, axiom[0], gr_.st_.EPSILON_, gr_.st_.EOL_});
-    Closure(initial.items_);
-    states_.insert(initial);
+    initial.SetKernel({{gr_.store_.Begin(axiom), 0}});
+    initial.closure_ = initial.kernel_;
+    Closure(initial.closure_);
+    states_.clear();
+    state_ids_.clear();
+    state_ids_.emplace(initial.kernel_, initial.id_);
+    states_.push_back(std::move(initial));
 }
 
 bool SLR1Parser::SolveLRConflicts(const state& st) {
-    for (const Lr0Item& item : st.items_) {
-        if (item.IsComplete()) {
-            // Regla 3: Si el ítem es del axioma, ACCEPT en EOL
-            if (item.antecedent_ == gr_.axiom_) {
-                actions_[st.id_][gr_.st_.EOL_] = {nullptr, Action::Accept};
-            } else {
-                // Regla 2: Si el ítem es completo, REDUCE en FOLLOW(A)
-                std::unordered_set<std::string> follows =
-                    Follow(item.antecedent_);
-                for (const std::string& sym : follows) {
-                    auto it = actions_[st.id_].find(sym);
-                    if (it != actions_[st.id_].end()) {
-                        // Si ya hay un Reduce, comparar las reglas.
-                        // REDUCE/REDUCE si reglas distintas
-                        if (it->second.action == Action::Reduce) {
-                            if (!(it->second.item->antecedent_ ==
-                                      item.antecedent_ &&
-                                  it->second.item->consequent_ ==
-                                      item.consequent_)) {
-                                return false;
-                            }
-                        } else {
-                            return false; // SHIFT/REDUCE
-                        }
-                    }
-                    actions_[st.id_][sym] = {&item, Action::Reduce};
-                }
-            }
-        } else {
-            // Regla 1: Si hay un terminal después del punto, hacemos SHIFT
-            std::string nextToDot = item.NextToDot();
-            if (gr_.st_.IsTerminal(nextToDot)) {
-                auto it = actions_[st.id_].find(nextToDot);
-                if (it != actions_[st.id_].end()) {
-                    // Si hay una acción previa, hay conflicto si es REDUCE
-                    if (it->second.action == Action::Reduce) {
-                        return false;
-                    }
-                    // Si ya hay un SHIFT en esa celda, no hay conflicto (varios
-                    // SHIFT están permitidos)
-                }
-                actions_[st.id_][nextToDot] = {nullptr, Action::Shift};
-            }
+    for (const Lr0ItemRef& ref : st.closure_) {
+        SymbolId lhs = gr_.store_.Lhs(ref.production_);
+        // Regla 2: Si el ítem es completo, REDUCE en FOLLOW(A)
+        if (!AddItemActions(st, ref, analysis_->Follow(lhs))) {
+            return false;
         }
     }
     return true;
 }
 
-bool SLR1Parser::MakeParser() {
-    ComputeFirstSets();
-    ComputeFollowSets();
-    MakeInitialState();
-    std::queue<unsigned int> pending;
-    pending.push(0);
-    unsigned int current = 0;
-    size_t       i       = 1;
-
-    do {
-        std::unordered_set<std::string> nextSymbols;
-        current = pending.front();
-        pending.pop();
-        auto it = std::find_if(
-            states_.begin(), states_.end(),
-            [current](const state& st) -> bool { return st.id_ == current; });
-        if (it == states_.end()) {
-            break;
+bool SLR1Parser::AddItemActions(const state& st, const Lr0ItemRef& ref,
+                                const TerminalSet& lookahead) {
+    const ProductionStore& store = gr_.store_;
+    PackedAction*          row   = &dense_actions_[st.id_ * action_columns_];
+
+    // Shifts are already in the dense row (MakeAutomaton fills them with the
+    // transitions), so any other action landing on a non-empty cell other
+    // than the same reduce is a conflict
+    if (!ref.IsComplete(store)) {
+        SymbolId next = ref.NextToDot(store);
+        if (gr_.st_.IsTerminal(next)) {
+            actions_[st.id_][gr_.st_.Name(next)] = {nullptr, Action::Shift};
         }
-        const state& qi = *it;
-        std::for_each(qi.items_.begin(), qi.items_.end(),
-                      [&](const Lr0Item& item) -> void {
-                          std::string next = item.NextToDot();
-                          if (next != gr_.st_.EPSILON_) {
-                              nextSymbols.insert(next);
-                          }
-                      });
-        for (const std::string& symbol : nextSymbols) {
-            state newState;
-            newState.id_ = i;
-            for (const auto& item : qi.items_) {
-                if (item.NextToDot() == symbol) {
-                    Lr0Item newItem = item;
-                    newItem.AdvanceDot();
-                    newState.items_.insert(newItem);
-                }
-            }
+        return true;
+    }
+    // Regla 3: Si el ítem es del axioma, ACCEPT en EOL
+    if (store.Lhs(ref.production_) == gr_.st_.GetId(gr_.axiom_)) {
+        if (ActionKind(row[SymbolTable::EOL_INDEX]) == Action::Reduce) {
+            return false;
+        }
+        row[SymbolTable::EOL_INDEX] =
+            PackAction(Action::Accept, ref.production_);
+        actions_[st.id_][gr_.st_.EOL_] = {nullptr, Action::Accept};
+        return true;
+    }
+    const Lr0Item* item   = &*st.items_.find(ToLr0Item(ref));
+    PackedAction   reduce = PackAction(Action::Reduce, ref.production_);
+    bool           solved = true;
+    lookahead.ForEach([&](std::uint32_t terminal) {
+        PackedAction cell = row[terminal];
+        if (cell == EMPTY_ACTION) {
+            row[terminal] = reduce;
+        } else if (!SameRule(cell, ref.production_)) {
+            solved = false;
+            return;
+        }
+        actions_[st.id_][gr_.st_.Name(gr_.st_.terminal_ids_[terminal])] = {
+            item, Action::Reduce};
+    });
+    return solved;
+}
 
-            Closure(newState.items_);
-            auto result = states_.insert(newState);
-            std::map<std::string, unsigned int> column;
-
-            if (result.second) {
-                pending.push(i);
-                if (transitions_.find(current) != transitions_.end()) {
-                    transitions_[current].insert({symbol, i});
-                } else {
-                    std::map<std::string, unsigned int> column;
-                    column.insert({symbol, i});
-                    transitions_.insert({current, column});
-                }
-                ++i;
-            } else {
-                if (transitions_.find(current) != transitions_.end()) {
-                    transitions_[current].insert({symbol, result.first->id_});
-                } else {
-                    std::map<std::string, unsigned int> column;
-                    column.insert({symbol, result.first->id_});
-                    transitions_.insert({current, column});
-                }
+bool SLR1Parser::SameRule(PackedAction action, ProductionId p) const {
+    if (ActionKind(action) != Action::Reduce) {
+        return false;
+    }
+    // A rule may be written more than once, reducing by either is the same
+    ProductionId q = ActionTarget(action);
+    return gr_.store_.Lhs(q) == gr_.store_.Lhs(p) &&
+           std::ranges::equal(gr_.store_.Rhs(q), gr_.store_.Rhs(p));
+}
+
+SLR1Parser::s_action SLR1Parser::ActionView(unsigned int state,
+                                            SymbolId     terminal) const {
+    PackedAction action = ActionAt(state, terminal);
+    Action       kind   = ActionKind(action);
+    if (kind != Action::Reduce) {
+        return {nullptr, kind};
+    }
+    ProductionId p    = ActionTarget(action);
+    auto         item = states_[state].items_.find(ToLr0Item(
+        {p, static_cast<std::uint32_t>(gr_.store_.Rhs(p).size())}));
+    return {&*item, kind};
+}
+
+SLR1Parser::ParseResult SLR1Parser::Parse(std::span<const SymbolId> tokens,
+                                          ParseStacks& stacks) const {
+    const ProductionStore&      store       = gr_.store_;
+    const SymbolTable&          st          = gr_.st_;
+    std::vector<std::uint32_t>& parse_stack = stacks.states;
+    std::vector<ProductionId>&  reductions  = stacks.reductions;
+    parse_stack.clear();
+    reductions.clear();
+    parse_stack.push_back(0);
+
+    // The input is tokens and the EOL closing the axiom. The end marker
+    // after it is read as EOL too, but nothing can be shifted there.
+    const std::size_t length   = tokens.size() + 1;
+    std::size_t       position = 0;
+    while (true) {
+        SymbolId token =
+            position < tokens.size() ? tokens[position] : SymbolTable::EOL_ID;
+        if (token >= st.Size() || !st.IsTerminal(token)) {
+            return {false, position, reductions};
+        }
+        PackedAction action =
+            dense_actions_[parse_stack.back() * action_columns_ +
+                           st.TerminalIndex(token)];
+        switch (ActionKind(action)) {
+        case Action::Shift:
+            if (position == length) {
+                return {false, tokens.size(), reductions};
             }
+            parse_stack.push_back(ActionTarget(action));
+            ++position;
+            break;
+        case Action::Reduce: {
+            ProductionId p = ActionTarget(action);
+            parse_stack.resize(parse_stack.size() - store.Rhs(p).size());
+            std::uint32_t to =
+                dense_gotos_[parse_stack.back() * goto_columns_ +
+                             st.NonTerminalIndex(store.Lhs(p))];
+            parse_stack.push_back(to);
+            reductions.push_back(p);
+            break;
         }
-        current++;
-    } while (!pending.empty());
+        case Action::Accept:
+            if (position != length) {
+                return {false, position, reductions};
+            }
+            reductions.push_back(ActionTarget(action));
+            return {true, 0, reductions};
+        case Action::Empty:
+            return {false, std::min(position, tokens.size()), reductions};
+        }
+    }
+}
+
+bool SLR1Parser::MakeParser() {
+    MakeAutomaton();
     for (const state& st : states_) {
         if (!SolveLRConflicts(st)) {
             return false;
@@ -289,6 +315,69 @@ bool SLR1Parser::MakeParser() {
     return true;
 }
 
+void SLR1Parser::MakeAutomaton() {
+    MakeInitialState();
+    actions_.clear();
+    transitions_.clear();
+    action_columns_ = gr_.st_.terminal_ids_.size();
+    goto_columns_   = gr_.st_.non_terminal_ids_.size();
+    dense_actions_.assign(action_columns_, EMPTY_ACTION);
+    dense_gotos_.assign(goto_columns_, NO_STATE);
+
+    // New states are appended, so walking states_ by index handles each one
+    // once, in the order they were found
+    for (unsigned int current = 0; current < states_.size(); ++current) {
+        std::vector<SymbolId> nextSymbols;
+        for (const Lr0ItemRef& item : states_[current].closure_) {
+            SymbolId next = item.NextToDot(gr_.store_);
+            if (next != SymbolTable::EPSILON_ID) {
+                nextSymbols.push_back(next);
+            }
+        }
+        std::sort(nextSymbols.begin(), nextSymbols.end());
+        nextSymbols.erase(std::unique(nextSymbols.begin(), nextSymbols.end()),
+                          nextSymbols.end());
+
+        for (SymbolId symbol : nextSymbols) {
+            // Most gotos lead to a known state: look the kernel up first and
+            // only close it when it is new
+            std::vector<Lr0ItemRef> kernel =
+                DeltaKernel(states_[current].closure_, symbol);
+            const auto [found, inserted] =
+                state_ids_.try_emplace(kernel, states_.size());
+            unsigned int to = found->second;
+            transitions_[current].insert({gr_.st_.Name(symbol), to});
+            if (gr_.st_.IsTerminal(symbol)) {
+                dense_actions_[current * action_columns_ +
+                               gr_.st_.TerminalIndex(symbol)] =
+                    PackAction(Action::Shift, to);
+            } else {
+                dense_gotos_[current * goto_columns_ +
+                             gr_.st_.NonTerminalIndex(symbol)] = to;
+            }
+            if (!inserted) {
+                continue;
+            }
+            dense_actions_.resize(dense_actions_.size() + action_columns_,
+                                  EMPTY_ACTION);
+            dense_gotos_.resize(dense_gotos_.size() + goto_columns_, NO_STATE);
+            state newState;
+            newState.id_ = to;
+            newState.SetKernel(std::move(kernel));
+            newState.closure_ = newState.kernel_;
+            Closure(newState.closure_);
+            states_.push_back(std::move(newState));
+        }
+    }
+
+    // The tutor and the action table work with string items, which are built
+    // once per state. states_ does not grow any more, so the items_ addresses
+    // stay stable.
+    for (state& st : states_) {
+        st.items_ = ToLr0Items(st.closure_);
+    }
+}
+
 void SLR1Parser::TeachAllItems() {
     std::cout << "What is an LR(0) item?\n";
     std::cout << "An LR(0) item represents a production rule with a 'dot' (•) "
@@ -339,9 +428,67 @@ void SLR1Parser::TeachAllItems() {
     std::cout << "Total LR(0) items generated: " << items.size() << "\n";
 }
 
+void SLR1Parser::BuildClosureTables() {
+    const ProductionStore& store = gr_.store_;
+    item_offsets_.resize(store.Size());
+    item_production_.clear();
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        item_offsets_[p] = static_cast<std::uint32_t>(item_production_.size());
+        item_production_.insert(item_production_.end(),
+                                store.Rhs(p).size() + 1, p);
+    }
+
+    const std::size_t symbols = gr_.st_.Size();
+    nt_closure_.assign(symbols, BitSet(item_production_.size()));
+    std::vector<std::vector<std::uint32_t>> starts_with(symbols);
+    for (ProductionId p = 0; p < store.Size(); ++p) {
+        SymbolId                  lhs = store.Lhs(p);
+        std::span<const SymbolId> rhs = store.Rhs(p);
+        nt_closure_[lhs].Insert(item_offsets_[p]);
+        if (!rhs.empty() && !gr_.st_.IsTerminal(rhs[0])) {
+            starts_with[lhs].push_back(rhs[0]);
+        }
+    }
+    Digraph(starts_with, nt_closure_);
+}
+
+void SLR1Parser::Closure(std::vector<Lr0ItemRef>& items) {
+    BitSet closure(item_production_.size());
+    for (const Lr0ItemRef& item : items) {
+        closure.Insert(ItemIndex(item));
+        SymbolId next = item.NextToDot(gr_.store_);
+        if (next != SymbolTable::EPSILON_ID && !gr_.st_.IsTerminal(next)) {
+            closure.Merge(nt_closure_[next]);
+        }
+    }
+
+    // The index is ordered by production and dot, so items come out sorted
+    items.clear();
+    closure.ForEach([&](std::uint32_t index) {
+        ProductionId p = item_production_[index];
+        items.push_back({p, index - item_offsets_[p]});
+    });
+}
+
 void SLR1Parser::Closure(std::unordered_set<Lr0Item>& items) {
-    std::unordered_set<std::string> visited;
-    ClosureUtil(items, items.size(), visited);
+    BitSet added(item_production_.size());
+    for (const Lr0Item& item : items) {
+        std::string next = item.NextToDot();
+        if (next == gr_.st_.EPSILON_ || gr_.st_.IsTerminal(next)) {
+            continue;
+        }
+        SymbolId id = gr_.st_.GetId(next);
+        if (id == SymbolTable::NO_SYMBOL || id >= nt_closure_.size()) {
+            std::unordered_set<std::string> visited;
+            ClosureUtil(items, items.size(), visited);
+            return;
+        }
+        added.Merge(nt_closure_[id]);
+    }
+    added.ForEach([&](std::uint32_t index) {
+        ProductionId p = item_production_[index];
+        items.insert(ToLr0Item({p, index - item_offsets_[p]}));
+    });
 }
 
 void SLR1Parser::ClosureUtil(std::unordered_set<Lr0Item>&     items,
@@ -376,10 +523,15 @@ std::string SLR1Parser::TeachClosure(std::unordered_set<Lr0Item>& items) {
     output << "Para el estado:\n";
     output << PrintItems(items);
 
+    // The listing comes from the closure tables, the walk-through only
+    // explains how it is reached
+    std::unordered_set<Lr0Item> closure = items;
+    Closure(closure);
+
     std::unordered_set<std::string> visited;
     TeachClosureUtil(items, items.size(), visited, 0, output);
     output << "Cierre:\n";
-    for (const Lr0Item& item : items) {
+    for (const Lr0Item& item : closure) {
         output << "  - ";
         output << item.ToString();
         output << "\n";
@@ -478,6 +630,32 @@ std::string SLR1Parser::TeachDeltaFunction(const std::unordered_set<Lr0Item>& it
     return output.str();
 }
 
+std::vector<Lr0ItemRef>
+SLR1Parser::DeltaKernel(const std::vector<Lr0ItemRef>& items,
+                        SymbolId                       symbol) const {
+    if (symbol == SymbolTable::EPSILON_ID) {
+        return {};
+    }
+    std::vector<Lr0ItemRef> kernel;
+    for (const Lr0ItemRef& item : items) {
+        if (item.NextToDot(gr_.store_) == symbol) {
+            kernel.push_back(item.Advanced());
+        }
+    }
+    std::sort(kernel.begin(), kernel.end());
+    kernel.erase(std::unique(kernel.begin(), kernel.end()), kernel.end());
+    return kernel;
+}
+
+std::vector<Lr0ItemRef>
+SLR1Parser::Delta(const std::vector<Lr0ItemRef>& items, SymbolId symbol) {
+    std::vector<Lr0ItemRef> delta_items = DeltaKernel(items, symbol);
+    if (!delta_items.empty()) {
+        Closure(delta_items);
+    }
+    return delta_items;
+}
+
 std::unordered_set<Lr0Item>
 SLR1Parser::Delta(const std::unordered_set<Lr0Item>& items,
                   const std::string&                 str) {
@@ -509,102 +687,83 @@ void SLR1Parser::TeachCanonicalCollection() {
     std::cout << "=== Process of Constructing the Canonical Collection of "
                  "LR(0) Items ===\n\n";
 
-    Lr0Item      init(gr_.axiom_, gr_.g_.at(gr_.axiom_)[0], gr_.st_.EPSILON_,
-                      gr_.st_.EOL_);
-    unsigned int id = 0;
-    std::unordered_set<state>   canonical_collection;
-    std::unordered_set<state>   to_add;
-    std::unordered_set<Lr0Item> current{init};
+    SymbolId                axiom = gr_.st_.GetId(gr_.axiom_);
+    Lr0ItemRef              init{gr_.store_.Begin(axiom), 0};
+    std::vector<state>      canonical_collection;
+    std::vector<Lr0ItemRef> current{init};
+    std::unordered_map<std::vector<Lr0ItemRef>, unsigned int, KernelHash> ids;
 
     std::cout << "=== Step 1: Initialize the Initial State ===\n";
     std::cout << "- Initial item: ";
-    init.PrintItem();
+    ToLr0Item(init).PrintItem();
     std::cout << "\n";
     std::cout << "- Closure:\n";
     Closure(current);
-    PrintItems(current);
+    PrintItems(ToLr0Items(current));
 
     state qi;
-    qi.id_    = id++;
-    qi.items_ = current;
-    canonical_collection.insert(qi);
-
-    std::unordered_set<state> visited;
+    qi.id_ = 0;
+    qi.SetKernel({init});
+    qi.closure_ = current;
+    ids.emplace(qi.kernel_, qi.id_);
+    canonical_collection.push_back(std::move(qi));
 
     std::map<std::pair<unsigned int, std::string>, unsigned int> transitions;
 
-    bool changed;
-    do {
-        changed = false;
-        std::cout << "\n=== Step 2: Compute Transitions ===\n";
+    std::cout << "\n=== Step 2: Compute Transitions ===\n";
+    // States found while processing one are appended and processed later
+    for (unsigned int i = 0; i < canonical_collection.size(); ++i) {
+        std::cout << "- Processing state " << i << ":\n";
+        std::cout << "  - Current set of items (I):\n";
+        PrintItems(ToLr0Items(canonical_collection[i].closure_));
+
+        std::cout << "  - For each grammar symbol X, compute δ(I, X):\n";
 
-        for (const state& st : canonical_collection) {
-            if (visited.find(st) != visited.end()) {
+        for (SymbolId sym = 0; sym < gr_.st_.Size(); ++sym) {
+            if (sym == SymbolTable::EOL_ID || sym == SymbolTable::EPSILON_ID) {
                 continue;
             }
+            const std::string& nt = gr_.st_.Name(sym);
+            std::cout << "    > Computing δ(I, " << nt << "):\n";
 
-            std::cout << "- Processing state " << st.id_ << ":\n";
-            std::cout << "  - Current set of items (I):\n";
-            PrintItems(st.items_);
-
-            std::cout << "  - For each grammar symbol X, compute δ(I, X):\n";
-
-            for (const auto& [nt, _] : gr_.st_.st_) {
-                if (nt == gr_.st_.EOL_ || nt == gr_.st_.EPSILON_) {
-                    continue;
-                }
-                std::cout << "    > Computing δ(I, " << nt << "):\n";
-
-                std::unordered_set<Lr0Item> delta_ret = Delta(st.items_, nt);
-
-                if (delta_ret.empty()) {
-                    std::cout << "      - δ(I, " << nt << ") = ∅\n";
-                } else {
-                    std::cout << "      - δ(I, " << nt << ") = {\n";
-                    PrintItems(delta_ret);
-                    std::cout << "      }\n";
-
-                    qi.id_    = id;
-                    qi.items_ = delta_ret;
-
-                    if (visited.find(qi) != visited.end() ||
-                        to_add.find(qi) != to_add.end() ||
-                        canonical_collection.find(qi) !=
-                            canonical_collection.end()) {
-                        std::cout << "      * This set is already in the "
-                                     "collection. Skipping.\n";
-                        const auto& it = canonical_collection.find(qi);
-                        transitions[{st.id_, nt}] = it->id_;
-                    } else {
-                        to_add.insert(qi);
-                        transitions[{st.id_, nt}] = qi.id_;
-                        std::cout << "      * This set is added to the "
-                                     "collection as state "
-                                  << id << ".\n";
-                        id++;
-                        changed = true;
-                    }
-                }
+            std::vector<Lr0ItemRef> kernel =
+                DeltaKernel(canonical_collection[i].closure_, sym);
+            if (kernel.empty()) {
+                std::cout << "      - δ(I, " << nt << ") = ∅\n";
+                continue;
             }
-
-            visited.insert(st);
+            std::vector<Lr0ItemRef> delta_ret = kernel;
+            Closure(delta_ret);
+            std::cout << "      - δ(I, " << nt << ") = {\n";
+            PrintItems(ToLr0Items(delta_ret));
+            std::cout << "      }\n";
+
+            const auto [found, inserted] =
+                ids.try_emplace(kernel, canonical_collection.size());
+            transitions[{i, nt}] = found->second;
+            if (!inserted) {
+                std::cout << "      * This set is already in the "
+                             "collection. Skipping.\n";
+                continue;
+            }
+            std::cout << "      * This set is added to the collection as "
+                         "state "
+                      << found->second << ".\n";
+            state next;
+            next.id_ = found->second;
+            next.SetKernel(std::move(kernel));
+            next.closure_ = std::move(delta_ret);
+            canonical_collection.push_back(std::move(next));
         }
-
-        canonical_collection.insert(to_add.begin(), to_add.end());
-        to_add.clear();
-    } while (changed);
+    }
 
     std::cout << "\n=== Canonical Collection Summary ===\n";
     std::cout << "- Total states: " << canonical_collection.size() << "\n";
     std::cout << "- States:\n";
 
-    for (unsigned int i = 0; i < canonical_collection.size(); ++i) {
-        const auto& current_st = std::find_if(
-            canonical_collection.begin(), canonical_collection.end(),
-            [i](const state& q) -> bool { return i == q.id_; });
-        const state st = *current_st;
-        std::cout << "  State " << i << ":\n";
-        PrintItems(st.items_);
+    for (const state& st : canonical_collection) {
+        std::cout << "  State " << st.id_ << ":\n";
+        PrintItems(ToLr0Items(st.closure_));
     }
 
     std::cout << "- Transitions:\n";
@@ -616,6 +775,33 @@ void SLR1Parser::TeachCanonicalCollection() {
     }
 }
 
+Lr0Item SLR1Parser::ToLr0Item(const Lr0ItemRef& item) const {
+    const ProductionStore&    store = gr_.store_;
+    std::span<const SymbolId> rhs   = store.Rhs(item.production_);
+    const std::string& antecedent   = gr_.st_.Name(store.Lhs(item.production_));
+    if (rhs.empty()) {
+        return {antecedent, {gr_.st_.EPSILON_}, 1, gr_.st_.EPSILON_,
+                gr_.st_.EOL_};
+    }
+    std::vector<std::string> consequent;
+    consequent.reserve(rhs.size());
+    for (SymbolId symbol : rhs) {
+        consequent.push_back(gr_.st_.Name(symbol));
+    }
+    return {antecedent, std::move(consequent), item.dot_, gr_.st_.EPSILON_,
+            gr_.st_.EOL_};
+}
+
+std::unordered_set<Lr0Item>
+SLR1Parser::ToLr0Items(const std::vector<Lr0ItemRef>& items) const {
+    std::unordered_set<Lr0Item> result;
+    result.reserve(items.size());
+    for (const Lr0ItemRef& item : items) {
+        result.insert(ToLr0Item(item));
+    }
+    return result;
+}
+
 std::string SLR1Parser::PrintItems(const std::unordered_set<Lr0Item>& items) {
     std::ostringstream output;
     for (const auto& item : items) {
@@ -627,119 +813,58 @@ std::string SLR1Parser::PrintItems(const std::unordered_set<Lr0Item>& items) {
 }
 
 void SLR1Parser::First(std::span<const std::string>     rule,
-                       std::unordered_set<std::string>& result) {
-    if (rule.empty() || (rule.size() == 1 && rule[0] == gr_.st_.EPSILON_)) {
-        result.insert(gr_.st_.EPSILON_);
+                      std::unordered_set<std::string>& result) {
+    if (!analysis_) {
         return;
     }
-
-    if (gr_.st_.IsTerminal(rule[0])) {
-        // EOL cannot be in first sets, if we reach EOL it means that the axiom
-        // is nullable, so epsilon is included instead
-        if (rule[0] == gr_.st_.EOL_) {
-            result.insert(gr_.st_.EPSILON_);
-            return;
+    const SymbolTable&    st = gr_.st_;
+    std::vector<SymbolId> ids;
+    ids.reserve(rule.size());
+    bool truncated = false;
+    for (const std::string& symbol : rule) {
+        if (symbol == st.EPSILON_) {
+            continue;
         }
-        result.insert(rule[0]);
-        return;
-    }
-
-    const std::unordered_set<std::string>& fii = first_sets_[rule[0]];
-    for (const auto& s : fii) {
-        if (s != gr_.st_.EPSILON_) {
-            result.insert(s);
+        SymbolId id = st.GetId(symbol);
+        // A symbol without FIRST set ends the string and cannot derive
+        // epsilon
+        if (id == SymbolTable::NO_SYMBOL ||
+            (!st.IsTerminal(id) && id >= analysis_->SymbolCount())) {
+            truncated = true;
+            break;
         }
+        ids.push_back(id);
     }
-
-    if (fii.find(gr_.st_.EPSILON_) == fii.cend()) {
-        return;
+    TerminalSet bits(analysis_->TerminalCount());
+    First(ids, bits);
+    if (truncated) {
+        bits.Erase(SymbolTable::EPSILON_INDEX);
     }
-    First(std::span<const std::string>(rule.begin() + 1, rule.end()), result);
+    result.merge(bits.ToStrings(st));
+}
+
+void SLR1Parser::First(std::span<const SymbolId> rule,
+                       TerminalSet&              result) const {
+    analysis_->First(rule, result);
 }
 
-// Least fixed point
 void SLR1Parser::ComputeFirstSets() {
-    // Init all FIRST to empty
-    for (const auto& [nonTerminal, _] : gr_.g_) {
-        first_sets_[nonTerminal] = {};
+    analysis_             = gr_.Analysis();
+    const SymbolTable& st = gr_.st_;
+    for (SymbolId nt : gr_.store_.non_terminals_) {
+        first_sets_[st.Name(nt)] = analysis_->First(nt).ToStrings(st);
     }
-
-    bool changed;
-    do {
-        auto old_first_sets = first_sets_; // Copy current state
-
-        for (const auto& [nonTerminal, productions] : gr_.g_) {
-            for (const auto& prod : productions) {
-                std::unordered_set<std::string> tempFirst;
-                First(prod, tempFirst);
-
-                if (tempFirst.find(gr_.st_.EOL_) != tempFirst.end()) {
-                    tempFirst.erase(gr_.st_.EOL_);
-                    tempFirst.insert(gr_.st_.EPSILON_);
-                }
-
-                auto& current_set = first_sets_[nonTerminal];
-                current_set.insert(tempFirst.begin(), tempFirst.end());
-            }
-        }
-
-        // Until all remain the same
-        changed = (old_first_sets != first_sets_);
-
-    } while (changed);
 }
 
 void SLR1Parser::ComputeFollowSets() {
-    for (const auto& [nt, _] : gr_.g_) {
-        follow_sets_[nt] = {};
-    }
-    follow_sets_[gr_.axiom_].insert(gr_.st_.EOL_);
-
-    bool changed;
-    do {
-        changed = false;
-        for (const auto& rule : gr_.g_) {
-            const std::string& lhs = rule.first;
-            for (const production& rhs : rule.second) {
-                for (size_t i = 0; i < rhs.size(); ++i) {
-                    const std::string& symbol = rhs[i];
-                    if (!gr_.st_.IsTerminal(symbol)) {
-                        std::unordered_set<std::string> first_remaining;
-
-                        if (i + 1 < rhs.size()) {
-                            First(std::span<const std::string>(
-                                      rhs.begin() + i + 1, rhs.end()),
-                                  first_remaining);
-                        } else {
-                            first_remaining.insert(gr_.st_.EPSILON_);
-                        }
-
-                        for (const std::string& terminal : first_remaining) {
-                            if (terminal != gr_.st_.EPSILON_) {
-                                if (follow_sets_[symbol]
-                                        .insert(terminal)
-                                        .second) {
-                                    changed = true;
-                                }
-                            }
-                        }
-
-                        if (first_remaining.find(gr_.st_.EPSILON_) !=
-                            first_remaining.end()) {
-                            for (const std::string& terminal :
-                                 follow_sets_[lhs]) {
-                                if (follow_sets_[symbol]
-                                        .insert(terminal)
-                                        .second) {
-                                    changed = true;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    } while (changed);
+    analysis_             = gr_.Analysis();
+    const SymbolTable& st = gr_.st_;
+    for (SymbolId nt : gr_.store_.non_terminals_) {
+        follow_sets_[st.Name(nt)] = analysis_->Follow(nt).ToStrings(st);
+    }
+    if (st.GetId(gr_.axiom_) == SymbolTable::NO_SYMBOL) {
+        follow_sets_[gr_.axiom_].insert(st.EOL_);
+    }
 }
 
 std::unordered_set<std::string> SLR1Parser::Follow(const std::string& arg) {
@@ -1,13 +1,21 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <span>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include "bitset.hpp"
 #include "grammar.hpp"
+#include "grammar_analysis.hpp"
 #include "lr0_item.hpp"
 #include "state.hpp"
+#include "terminal_set.hpp"
 
 class SLR1Parser {
   public:
@@ -70,8 +78,87 @@ class SLR1Parser {
     using transition_table =
         std::map<unsigned int, std::map<std::string, unsigned int>>;
 
+    /**
+     * @brief An entry of the dense ACTION table packed in 32 bits: the kind
+     * of action in the top two bits and its target in the rest.
+     *
+     * The target is the destination state of a shift, the ProductionId of a
+     * reduce and the axiom production an accept completes. An empty entry is
+     * 0.
+     */
+    using PackedAction = std::uint32_t;
+
+    /// @brief Packed entry of an empty ACTION cell.
+    static constexpr PackedAction EMPTY_ACTION = 0;
+
+    /// @brief Entry of the dense GOTO table where there is no transition.
+    static constexpr std::uint32_t NO_STATE = static_cast<std::uint32_t>(-1);
+
+    /// @brief Packs an action of the given kind and target.
+    static constexpr PackedAction PackAction(Action kind, std::uint32_t target) {
+        std::uint32_t code = kind == Action::Shift    ? 1
+                             : kind == Action::Reduce ? 2
+                             : kind == Action::Accept ? 3
+                                                      : 0;
+        return code == 0 ? EMPTY_ACTION : (code << 30) | target;
+    }
+
+    /// @brief Kind of a packed action.
+    static constexpr Action ActionKind(PackedAction action) {
+        switch (action >> 30) {
+        case 1:
+            return Action::Shift;
+        case 2:
+            return Action::Reduce;
+        case 3:
+            return Action::Accept;
+        default:
+            return Action::Empty;
+        }
+    }
+
+    /// @brief Target of a packed action: a state for a shift, a production
+    /// for a reduce or an accept.
+    static constexpr std::uint32_t ActionTarget(PackedAction action) {
+        return action & ((std::uint32_t{1} << 30) - 1);
+    }
+
+    /**
+     * @brief Outcome of Parse.
+     *
+     * @var accepted Whether the input is a sentence of the grammar.
+     * @var error_position Index of the token no action was found for, or the
+     * number of tokens if the input ended too early. 0 when accepted.
+     * @var reductions Productions reduced by, in order, ending with the
+     * axiom production accepted on: a rightmost derivation of the axiom in
+     * reverse. It points into the ParseStacks used and stays valid until
+     * they parse again.
+     */
+    struct ParseResult {
+        bool                          accepted;
+        std::size_t                   error_position;
+        std::span<const ProductionId> reductions;
+    };
+
+    /**
+     * @brief Working memory of Parse. Each thread parsing with the same
+     * tables needs its own.
+     *
+     * @var states The state stack.
+     * @var reductions Reductions made by the last parse.
+     */
+    struct ParseStacks {
+        std::vector<std::uint32_t> states;
+        std::vector<ProductionId>  reductions;
+    };
+
     SLR1Parser() = default;
     SLR1Parser(Grammar gr);
+    SLR1Parser(const SLR1Parser&)            = default;
+    SLR1Parser(SLR1Parser&&)                 = default;
+    SLR1Parser& operator=(const SLR1Parser&) = default;
+    SLR1Parser& operator=(SLR1Parser&&)      = default;
+    virtual ~SLR1Parser()                    = default;
 
     /**
      * @brief Retrieves all LR(0) items in the grammar.
@@ -84,6 +171,62 @@ class SLR1Parser {
      */
     std::unordered_set<Lr0Item> AllItems() const;
 
+    /**
+     * @brief ACTION entry of a state for a terminal, read from the dense
+     * table built by MakeParser.
+     *
+     * @param state Id of the state.
+     * @param terminal SymbolId of the terminal.
+     */
+    PackedAction ActionAt(unsigned int state, SymbolId terminal) const {
+        return dense_actions_[state * action_columns_ +
+                              gr_.st_.TerminalIndex(terminal)];
+    }
+
+    /**
+     * @brief GOTO entry of a state for a non-terminal, read from the dense
+     * table built by MakeParser.
+     *
+     * @return The destination state, or NO_STATE if there is none.
+     */
+    std::uint32_t GotoAt(unsigned int state, SymbolId non_terminal) const {
+        return dense_gotos_[state * goto_columns_ +
+                            gr_.st_.NonTerminalIndex(non_terminal)];
+    }
+
+    /**
+     * @brief Decodes an ACTION entry as the s_action used by the tutor, with
+     * the reduce item pointing into the state's items_.
+     */
+    s_action ActionView(unsigned int state, SymbolId terminal) const;
+
+    /**
+     * @brief Parses a sequence of terminals with the ACTION and GOTO tables
+     * built by MakeParser.
+     *
+     * The EOL the axiom ends with is not part of tokens: Parse reads it
+     * after the last token, and the input ends there. The stacks are
+     * cleared, not released, so once they have grown to the size of the
+     * inputs a parse allocates nothing. The tables are only read: threads
+     * can share a parser as long as each one has its own stacks.
+     *
+     * It only reads the dense tables, so it runs the LALR(1) and LR(1)
+     * tables of the derived parsers as well.
+     *
+     * @param tokens SymbolIds of the terminals of the input.
+     * @param stacks Working memory, see ParseStacks.
+     */
+    ParseResult Parse(std::span<const SymbolId> tokens,
+                      ParseStacks&              stacks) const;
+
+    /// @brief Parses with the parser's own parse_stacks_, see above.
+    ParseResult Parse(std::span<const SymbolId> tokens) {
+        return Parse(tokens, parse_stacks_);
+    }
+
+    /// @brief Creates the working memory of Parse for another thread.
+    ParseStacks MakeParseStacks() const { return {}; }
+
     /**
      * @brief Prints debug information about the parser's states.
      *
@@ -111,6 +254,10 @@ class SLR1Parser {
      * grammar's productions. The closure operation ensures that all possible
      * derivations are considered when constructing the parser's states.
      *
+     * Non-terminals after a dot are looked up in the precomputed closure
+     * tables (see BuildClosureTables); ClosureUtil is only used for symbols
+     * the grammar does not define.
+     *
      * @param items The set of LR(0) items for which to compute the closure.
      */
     void Closure(std::unordered_set<Lr0Item>& items);
@@ -131,8 +278,70 @@ class SLR1Parser {
     void ClosureUtil(std::unordered_set<Lr0Item>& items, unsigned int size,
                      std::unordered_set<std::string>& visited);
 
+    /**
+     * @brief Computes the closure of a set of compact LR(0) items.
+     *
+     * Same operation as the string version, but working on production ids:
+     * the closure is the union of the items themselves and the precomputed
+     * closure of every non-terminal found after a dot. On return, items is
+     * sorted and free of duplicates.
+     *
+     * @param items The items to close, extended in place.
+     */
+    void Closure(std::vector<Lr0ItemRef>& items);
+
     std::unordered_set<Lr0Item> Delta(const std::unordered_set<Lr0Item>& items,
                                       const std::string&                 str);
+
+    /**
+     * @brief Computes δ(items, symbol) over compact LR(0) items: the closure of
+     * the items that have symbol after the dot, with the dot advanced.
+     *
+     * @param items A closed set of items.
+     * @param symbol The symbol to move over.
+     * @return The closed, sorted item set reached, empty if there is none.
+     */
+    std::vector<Lr0ItemRef> Delta(const std::vector<Lr0ItemRef>& items,
+                                  SymbolId                       symbol);
+
+    /**
+     * @brief Computes the kernel of δ(items, symbol): the items that have
+     * symbol after the dot, with the dot advanced, before closing them.
+     *
+     * @param items A closed set of items.
+     * @param symbol The symbol to move over.
+     * @return The sorted kernel reached, empty if there is none.
+     */
+    std::vector<Lr0ItemRef> DeltaKernel(const std::vector<Lr0ItemRef>& items,
+                                        SymbolId symbol) const;
+
+    /**
+     * @brief Resolves a compact item into the string item used by the tutor.
+     *
+     * Epsilon productions are written as { EPSILON } with the dot after it.
+     */
+    Lr0Item ToLr0Item(const Lr0ItemRef& item) const;
+
+    /// @brief Resolves a set of compact items, see ToLr0Item.
+    std::unordered_set<Lr0Item>
+    ToLr0Items(const std::vector<Lr0ItemRef>& items) const;
+
+    /// @brief Position of a compact item in the item index.
+    std::uint32_t ItemIndex(const Lr0ItemRef& item) const {
+        return item_offsets_[item.production_] + item.dot_;
+    }
+
+    /**
+     * @brief Builds the item index and the closure of every non-terminal.
+     *
+     * The item index numbers the items of AllItems() production by
+     * production, with the dot from 0 to |rhs|; an epsilon production has
+     * a single item. nt_closure_[A] holds the items with the dot at the
+     * start of every production reachable from A through leftmost
+     * non-terminals, i.e. everything closing an item ·A adds. It is solved
+     * with Digraph over the relation A → B for each production A → Bβ.
+     */
+    void BuildClosureTables();
     /**
      * @brief Resolves LR conflicts in a given state.
      *
@@ -147,6 +356,22 @@ class SLR1Parser {
      */
     bool SolveLRConflicts(const state& st);
 
+    /**
+     * @brief Adds the actions of one item of a state to both action tables.
+     *
+     * An item with a terminal after the dot adds its shift to actions_ (the
+     * dense table already has it). A complete item of the axiom accepts on
+     * EOL, any other complete item reduces on every terminal of lookahead.
+     *
+     * @return `false` if an action collides with a different one.
+     */
+    bool AddItemActions(const state& st, const Lr0ItemRef& ref,
+                        const TerminalSet& lookahead);
+
+    /// @brief Checks if a packed action reduces by the same rule as
+    /// production p.
+    bool SameRule(PackedAction action, ProductionId p) const;
+
     /**
      * @brief Calculates the FIRST set for a given production rule in a grammar.
      *
@@ -175,15 +400,23 @@ class SLR1Parser {
      */
     void First(std::span<const std::string>     rule,
                std::unordered_set<std::string>& result);
+
+    /**
+     * @brief Calculates the FIRST set of a sequence of symbol ids, usually a
+     * right-hand side taken from the grammar's ProductionStore.
+     *
+     * @param rule The symbols whose FIRST set is computed. An empty span
+     * stands for epsilon.
+     * @param result Set where the FIRST terminals are added.
+     */
+    void First(std::span<const SymbolId> rule, TerminalSet& result) const;
     /**
      * @brief Computes the FIRST sets for all non-terminal symbols in the
      * grammar.
      *
-     * This function calculates the FIRST set for each non-terminal symbol in
-     * the grammar by iteratively applying a least fixed-point algorithm. This
-     * approach ensures that the FIRST sets are fully populated by repeatedly
-     * expanding and updating the sets until no further changes occur (i.e., a
-     * fixed-point is reached).
+     * The sets come from the grammar's GrammarAnalysis (see
+     * Grammar::Analysis), which is computed once per grammar and shared; this
+     * function converts them to strings and stores them in `first_sets_`.
      */
     void ComputeFirstSets();
 
@@ -197,20 +430,12 @@ class SLR1Parser {
      * a derivation, the end-of-input marker (`$`) is included in its FOLLOW
      * set.
      *
-     * This function computes the FOLLOW sets using the following rules:
-     * 1. Initialize FOLLOW(S) = { $ }, where S is the start symbol.
-     * 2. For each production rule of the form A → αBβ:
-     *    - Add FIRST(β) (excluding ε) to FOLLOW(B).
-     *    - If ε ∈ FIRST(β), add FOLLOW(A) to FOLLOW(B).
-     * 3. Repeat step 2 until no changes occur in any FOLLOW set.
+     * The sets come from the grammar's GrammarAnalysis (see
+     * Grammar::Analysis), which is computed once per grammar and shared.
      *
      * The computed FOLLOW sets are cached in the `follow_sets_` member variable
      * for later use by the parser.
      *
-     * @note This function assumes that the FIRST sets for all symbols have
-     * already been computed and are available in the `first_sets_` member
-     * variable.
-     *
      * @see First
      * @see follow_sets_
      */
@@ -237,7 +462,7 @@ class SLR1Parser {
      *
      * This function initializes the starting state of the parser by computing
      * the closure of the initial set of LR(0) items derived from the grammar's
-     * start symbol. The initial state is added to the `states_` set, and its
+     * start symbol. The initial state is added to the `states_` vector, and its
      * transitions are prepared for further processing in the parser
      * construction.
      *
@@ -259,11 +484,23 @@ class SLR1Parser {
      * @return `true` if the parsing tables are successfully constructed,
      * `false` if the grammar is not SLR(1) or a conflict is encountered.
      *
+     * LALR1Parser and LR1Parser override it, so tables built through an
+     * SLR1Parser reference are the ones of the object's own construction.
+     *
      * @see actions_
      * @see transitions_
      * @see states_
      */
-    bool MakeParser();
+    virtual bool MakeParser();
+
+    /**
+     * @brief Builds the LR(0) automaton: states_, transitions_, the shifts
+     * of dense_actions_ and dense_gotos_. No reduction is added.
+     *
+     * MakeParser completes it with SLR(1) reductions; LALR1Parser reuses it
+     * with its own lookaheads.
+     */
+    void MakeAutomaton();
 
     void TeachAllItems();
     std::string TeachClosure(std::unordered_set<Lr0Item>& items);
@@ -285,14 +522,52 @@ class SLR1Parser {
     std::unordered_map<std::string, std::unordered_set<std::string>>
         follow_sets_;
 
+    /// @brief Analysis of gr_, shared with every other user of the same
+    /// grammar. first_sets_ and follow_sets_ are built from it.
+    std::shared_ptr<const GrammarAnalysis> analysis_;
+
     /// @brief The action table used by the parser to determine shift/reduce
-    /// actions.
+    /// actions, by symbol name. It holds the same entries as dense_actions_
+    /// and is kept for the tutor.
     action_table actions_;
 
     /// @brief The transition table used by the parser to determine state
     /// transitions.
     transition_table transitions_;
 
-    /// @brief The set of states in the parser's state machine.
-    std::unordered_set<state> states_;
+    /// @brief Index of the first item of each production in the item index;
+    /// item (p, dot) is item_offsets_[p] + dot.
+    std::vector<std::uint32_t> item_offsets_;
+
+    /// @brief Production of each item in the item index.
+    std::vector<ProductionId> item_production_;
+
+    /// @brief Closure of each non-terminal over the item index, indexed by
+    /// SymbolId. Other symbols have an empty set.
+    std::vector<BitSet> nt_closure_;
+
+    /// @brief Number of columns of dense_actions_, one per terminal index.
+    std::size_t action_columns_{0};
+
+    /// @brief Number of columns of dense_gotos_, one per non-terminal index.
+    std::size_t goto_columns_{0};
+
+    /// @brief ACTION table, row-major by state and terminal index. Shifts are
+    /// stored here and not in dense_gotos_.
+    std::vector<PackedAction> dense_actions_;
+
+    /// @brief GOTO table, row-major by state and non-terminal index.
+    std::vector<std::uint32_t> dense_gotos_;
+
+    /// @brief Stacks of Parse when it is called without any, kept between
+    /// calls.
+    ParseStacks parse_stacks_;
+
+    /// @brief The states of the parser's state machine, indexed by id_.
+    std::vector<state> states_;
+
+    /// @brief Id of each state in states_, by kernel. MakeParser looks every
+    /// goto up here before closing it.
+    std::unordered_map<std::vector<Lr0ItemRef>, unsigned int, KernelHash>
+        state_ids_;
 };
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "grammar.hpp"
+#include "slr1_parser.hpp"
+#include "slr1_recognizer.hpp"
+#include "symbol_table.hpp"
+#include "terminal_set.hpp"
+
+SLR1Recognizer::SLR1Recognizer(const SLR1Parser& parser)
+    : parser_(parser), expected_(parser.action_columns_) {
+    Reset();
+}
+
+void SLR1Recognizer::Reset() {
+    stack_.assign(1, 0);
+    scratch_.clear();
+    base_           = 1;
+    position_       = 0;
+    expected_valid_ = false;
+}
+
+bool SLR1Recognizer::Run(std::uint32_t terminal, bool end) {
+    const ProductionStore& store = parser_.gr_.store_;
+    const SymbolTable&     st    = parser_.gr_.st_;
+    while (true) {
+        SLR1Parser::PackedAction action =
+            parser_.dense_actions_[Top() * parser_.action_columns_ + terminal];
+        switch (SLR1Parser::ActionKind(action)) {
+        case SLR1Parser::Action::Shift:
+            scratch_.push_back(SLR1Parser::ActionTarget(action));
+            return !end;
+        case SLR1Parser::Action::Reduce: {
+            ProductionId p      = SLR1Parser::ActionTarget(action);
+            std::size_t  n      = store.Rhs(p).size();
+            std::size_t  popped = std::min(n, scratch_.size());
+            // Pop from the scratch states first, then from the stack
+            scratch_.resize(scratch_.size() - popped);
+            base_ -= n - popped;
+            scratch_.push_back(
+                parser_.dense_gotos_[Top() * parser_.goto_columns_ +
+                                     st.NonTerminalIndex(store.Lhs(p))]);
+            break;
+        }
+        case SLR1Parser::Action::Accept:
+            return end;
+        case SLR1Parser::Action::Empty:
+            return false;
+        }
+    }
+}
+
+bool SLR1Recognizer::Feed(SymbolId token) {
+    const SymbolTable& st = parser_.gr_.st_;
+    Rewind();
+    if (token >= st.Size() || !st.IsTerminal(token) ||
+        !Run(st.TerminalIndex(token), false)) {
+        return false;
+    }
+    stack_.resize(base_);
+    stack_.insert(stack_.end(), scratch_.begin(), scratch_.end());
+    ++position_;
+    expected_valid_ = false;
+    return true;
+}
+
+bool SLR1Recognizer::Finish() {
+    // Shift the EOL of the axiom, then read the end of the input from there
+    Rewind();
+    return Run(SymbolTable::EOL_INDEX, false) &&
+           Run(SymbolTable::EOL_INDEX, true);
+}
+
+const TerminalSet& SLR1Recognizer::Expected() {
+    if (!expected_valid_) {
+        expected_.Clear();
+        for (std::uint32_t terminal = 0; terminal < parser_.action_columns_;
+             ++terminal) {
+            Rewind();
+            bool fits = terminal == SymbolTable::EOL_INDEX
+                            ? Finish()
+                            : Run(terminal, false);
+            if (fits) {
+                expected_.Insert(terminal);
+            }
+        }
+        expected_valid_ = true;
+    }
+    return expected_;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "slr1_parser.hpp"
+#include "symbol_table.hpp"
+#include "terminal_set.hpp"
+
+/**
+ * @class SLR1Recognizer
+ * @brief Push-style recognizer over the tables of an SLR1Parser: tokens are
+ * fed one at a time and the state stack is kept between calls.
+ *
+ * It reads the same dense ACTION and GOTO tables as SLR1Parser::Parse, with
+ * the same input convention, so LALR1Parser and LR1Parser tables work too.
+ * The parser must outlive the recognizer and keep its tables unchanged, and
+ * its grammar must not have unproductive symbols (see SLR1Parser::Parse).
+ *
+ * Feeding a token runs the reductions it causes on a scratch copy of the top
+ * of the stack and only commits them once the token is shifted: a token that
+ * does not fit leaves the recognizer as it was, which lets an interactive
+ * front end refuse a keystroke and go on. Each Feed costs the reductions it
+ * makes, amortized O(1) per token, and allocates nothing once the stacks
+ * have grown.
+ */
+class SLR1Recognizer {
+  public:
+    explicit SLR1Recognizer(const SLR1Parser& parser);
+
+    /// @brief Goes back to the start of the input.
+    void Reset();
+
+    /**
+     * @brief Feeds the next token of the input.
+     *
+     * @param token SymbolId of a terminal.
+     * @return `true` if the token was shifted, `false` if it cannot come
+     * next; then nothing changes.
+     */
+    bool Feed(SymbolId token);
+
+    /**
+     * @brief Checks whether the input can end after the tokens fed so far,
+     * reading the EOL the axiom ends with and the end of the input.
+     *
+     * The recognizer does not change, so more tokens can still be fed.
+     */
+    bool Finish();
+
+    /**
+     * @brief Terminals that Feed would accept now, by terminal index. EOL
+     * stands for the end of the input, i.e. Finish would succeed.
+     *
+     * The set is computed on the first call after a change and kept until
+     * the next one.
+     */
+    const TerminalSet& Expected();
+
+    /// @brief Number of tokens fed and shifted since the start.
+    std::size_t Position() const { return position_; }
+
+  private:
+    /// @brief Makes the stack seen by Run the committed one again.
+    void Rewind() {
+        scratch_.clear();
+        base_ = stack_.size();
+    }
+
+    /**
+     * @brief Runs the actions for a terminal until it is shifted, on the
+     * stack formed by stack_[0, base_) and scratch_, which it updates
+     * without touching stack_.
+     *
+     * @param terminal Terminal index of the token.
+     * @param end Whether the token is the end of the input, which is
+     * accepted instead of shifted.
+     * @return Whether the token is shifted, or accepted at the end.
+     */
+    bool Run(std::uint32_t terminal, bool end);
+
+    /// @brief Top of the stack formed by stack_[0, base_) and scratch_.
+    std::uint32_t Top() const {
+        return scratch_.empty() ? stack_[base_ - 1] : scratch_.back();
+    }
+
+    const SLR1Parser& parser_;
+
+    /// @brief Committed state stack.
+    std::vector<std::uint32_t> stack_;
+
+    /// @brief States pushed by Run above stack_[0, base_).
+    std::vector<std::uint32_t> scratch_;
+    std::size_t                base_{0};
+
+    std::size_t position_{0};
+    TerminalSet expected_;
+    bool        expected_valid_{false};
+};
@@ -1,27 +1,71 @@
 #pragma once
 #include "lr0_item.hpp"
-#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <numeric>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 struct state {
+    /// @brief Items of the state as strings, as shown by the tutor.
     std::unordered_set<Lr0Item> items_;
-    unsigned int                id_;
 
-    bool operator==(const state& other) const { return other.items_ == items_; }
+    /// @brief Kernel of the state (the items the closure starts from), sorted
+    /// and without duplicates. It identifies the state.
+    std::vector<Lr0ItemRef> kernel_;
+
+    /// @brief Closed item set of the state, sorted and without duplicates.
+    std::vector<Lr0ItemRef> closure_;
+
+    /// @brief Hash of kernel_, computed by SetKernel.
+    std::size_t hash_ = 0;
+
+    unsigned int id_;
+
+    /**
+     * @brief Sets the kernel of the state and caches its hash.
+     *
+     * @param kernel Kernel items, sorted and without duplicates.
+     */
+    void SetKernel(std::vector<Lr0ItemRef> kernel) {
+        kernel_ = std::move(kernel);
+        hash_   = HashKernel(kernel_);
+    }
+
+    /**
+     * @brief Order-dependent 64-bit hash of a sorted kernel.
+     */
+    static std::size_t HashKernel(const std::vector<Lr0ItemRef>& kernel) {
+        std::uint64_t h = 0x9e3779b97f4a7c15ULL ^ kernel.size();
+        for (const Lr0ItemRef& item : kernel) {
+            h ^= std::hash<Lr0ItemRef>()(item);
+            h *= 0xbf58476d1ce4e5b9ULL;
+            h ^= h >> 31;
+        }
+        h ^= h >> 30;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 27;
+        return static_cast<std::size_t>(h);
+    }
+
+    bool operator==(const state& other) const {
+        return other.hash_ == hash_ && other.kernel_ == kernel_;
+    }
+};
+
+/**
+ * @brief Hashes a sorted kernel the same way state does, to intern kernels
+ * without building a state.
+ */
+struct KernelHash {
+    std::size_t operator()(const std::vector<Lr0ItemRef>& kernel) const {
+        return state::HashKernel(kernel);
+    }
 };
 
 namespace std {
 template <> struct hash<state> {
-    size_t operator()(const state& st) const {
-        size_t seed =
-            std::accumulate(st.items_.begin(), st.items_.end(), 0,
-                            [](size_t acc, const Lr0Item& item) {
-                                return acc ^ (std::hash<Lr0Item>()(item));
-                            });
-        return seed;
-    }
+    size_t operator()(const state& st) const { return st.hash_; }
 };
 } // namespace std
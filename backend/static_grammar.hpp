@@ -0,0 +1,703 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+/// @brief A rule of a StaticGrammar, such as `{"A", "a A b"}`.
+struct StaticRule {
+    /// @brief Antecedent, a non-terminal.
+    std::string_view lhs;
+    /// @brief Consequent: symbols separated by spaces, empty or EPSILON for
+    /// the empty string.
+    std::string_view rhs;
+};
+
+/// @brief Callback of the StaticLL1Table and StaticSLR1Table parsers that
+/// does nothing.
+struct IgnoreProductions {
+    constexpr void operator()(std::uint32_t) const {}
+};
+
+/// @brief Outcome of the StaticLL1Table and StaticSLR1Table parsers, with
+/// the meaning of SLR1Parser::ParseResult.
+struct StaticParseResult {
+    bool        accepted;
+    std::size_t error_position;
+};
+
+/**
+ * @class StaticGrammar
+ * @brief Grammar whose symbols, productions, FIRST and FOLLOW sets are built
+ * by a `constexpr` constructor, for grammars fixed at build time.
+ *
+ * It follows the conventions of Grammar: symbols starting with a lowercase
+ * letter are terminals and the rest non-terminals, EPSILON stands for the
+ * empty string and the axiom S → A $ is added, so A is the start symbol and
+ * S cannot have rules of its own. Symbol 0 is the EOL and symbol 1 EPSILON,
+ * with terminal indices 0 and 1 as in SymbolTable. FIRST and FOLLOW follow
+ * GrammarAnalysis, including EOL counting as epsilon in FIRST, and FIRST
+ * holds EPSILON_INDEX for nullable symbols.
+ *
+ * Everything is stored in arrays sized by the template parameters, so the
+ * grammar is a literal type: declared `constexpr` it needs no construction
+ * at startup and its sets can be checked with `static_assert`. It can be
+ * built at run time too.
+ *
+ * @code
+ * constexpr StaticGrammar gr{{{"A", "a b A"}, {"A", "a"}}};
+ * static_assert(!gr.Nullable(gr.GetId("A")));
+ * @endcode
+ *
+ * @tparam Rules Maximum number of rules.
+ * @tparam MaxRhs Maximum number of symbols on a right-hand side.
+ */
+template <std::size_t Rules, std::size_t MaxRhs = 8>
+class StaticGrammar {
+  public:
+    static_assert(MaxRhs >= 2, "S -> A $ needs two symbols");
+
+    static constexpr std::size_t MAX_SYMBOLS     = 3 + Rules * (MaxRhs + 1);
+    static constexpr std::size_t MAX_PRODUCTIONS = Rules + 1;
+    static constexpr std::size_t MAX_RHS         = MaxRhs;
+
+    static constexpr std::uint32_t NO_SYMBOL     = 0xffffffff;
+    static constexpr std::uint32_t EOL_ID        = 0;
+    static constexpr std::uint32_t EPSILON_ID    = 1;
+    static constexpr std::uint32_t EOL_INDEX     = 0;
+    static constexpr std::uint32_t EPSILON_INDEX = 1;
+
+    /// @brief Set of terminal indices.
+    using Terminals = std::array<bool, MAX_SYMBOLS>;
+
+    /// @brief Builds a grammar from exactly Rules rules, which lets the
+    /// number of rules be deduced from a braced list.
+    constexpr StaticGrammar(const StaticRule (&rules)[Rules])
+        : StaticGrammar(std::span<const StaticRule>(rules)) {}
+
+    /**
+     * @brief Builds a grammar from at most Rules rules.
+     *
+     * @throw std::length_error if there are more than Rules rules or a
+     * right-hand side longer than MaxRhs; in a constant expression, this is
+     * a compile error.
+     * @throw std::invalid_argument if a rule is for S. Grammar drops such
+     * rules in favour of the axiom S → A $; here they are an error instead.
+     */
+    constexpr explicit StaticGrammar(std::span<const StaticRule> rules) {
+        if (rules.size() > Rules) {
+            throw std::length_error("StaticGrammar: too many rules");
+        }
+        Intern("$");
+        Intern("EPSILON");
+        for (const StaticRule& rule : rules) {
+            if (rule.lhs == "S") {
+                throw std::invalid_argument(
+                    "StaticGrammar: S is the axiom S -> A $");
+            }
+            std::uint32_t p = static_cast<std::uint32_t>(production_count_++);
+            std::string_view rest = rule.rhs;
+            lhs_[p]               = Intern(rule.lhs);
+            while (!rest.empty()) {
+                std::size_t      space = rest.find(' ');
+                std::string_view name  = rest.substr(0, space);
+                rest = space == rest.npos ? std::string_view{}
+                                          : rest.substr(space + 1);
+                if (name.empty() || name == "EPSILON") {
+                    continue;
+                }
+                if (rhs_length_[p] == MaxRhs) {
+                    throw std::length_error(
+                        "StaticGrammar: right-hand side longer than MaxRhs");
+                }
+                rhs_[p][rhs_length_[p]++] = Intern(name);
+            }
+        }
+        axiom_          = Intern("S");
+        std::uint32_t p = static_cast<std::uint32_t>(production_count_++);
+        lhs_[p]         = axiom_;
+        rhs_[p][0]      = Intern("A");
+        rhs_[p][1]      = EOL_ID;
+        rhs_length_[p]  = 2;
+
+        ComputeFirst();
+        ComputeFollow();
+    }
+
+    /// @brief Id of a symbol, or NO_SYMBOL.
+    constexpr std::uint32_t GetId(std::string_view name) const {
+        for (std::uint32_t id = 0; id < symbol_count_; ++id) {
+            if (names_[id] == name) {
+                return id;
+            }
+        }
+        return NO_SYMBOL;
+    }
+
+    /// @brief Terminal index of a name, or terminal_count_ if there is none.
+    constexpr std::uint32_t FindTerminal(std::string_view name) const {
+        std::uint32_t id = GetId(name);
+        return id != NO_SYMBOL && terminal_[id]
+                   ? kind_index_[id]
+                   : static_cast<std::uint32_t>(terminal_count_);
+    }
+
+    constexpr bool IsTerminal(std::uint32_t id) const { return terminal_[id]; }
+
+    /// @brief Index of a terminal among the terminals, as in SymbolTable.
+    constexpr std::uint32_t TerminalIndex(std::uint32_t id) const {
+        return kind_index_[id];
+    }
+
+    /// @brief Index of a non-terminal among the non-terminals.
+    constexpr std::uint32_t NonTerminalIndex(std::uint32_t id) const {
+        return kind_index_[id];
+    }
+
+    /// @brief Whether a symbol derives the empty string.
+    constexpr bool Nullable(std::uint32_t id) const {
+        return first_[id][EPSILON_INDEX];
+    }
+
+    /**
+     * @brief Adds FIRST of production p from position from on to out,
+     * without EPSILON_INDEX.
+     *
+     * @return Whether that suffix derives the empty string.
+     */
+    constexpr bool SuffixFirst(std::uint32_t p, std::uint32_t from,
+                               Terminals& out) const {
+        for (std::uint32_t i = from; i < rhs_length_[p]; ++i) {
+            std::uint32_t symbol = rhs_[p][i];
+            if (symbol == EOL_ID) {
+                return true;
+            }
+            if (terminal_[symbol]) {
+                out[kind_index_[symbol]] = true;
+                return false;
+            }
+            for (std::size_t t = 0; t < terminal_count_; ++t) {
+                out[t] = out[t] || (t != EPSILON_INDEX && first_[symbol][t]);
+            }
+            if (!Nullable(symbol)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Terminals that select production p in an LL(1) table.
+    constexpr Terminals PredictionSymbols(std::uint32_t p) const {
+        Terminals prediction{};
+        if (SuffixFirst(p, 0, prediction)) {
+            Merge(prediction, follow_[lhs_[p]]);
+        }
+        return prediction;
+    }
+
+    /// @brief Whether productions p and q are the same rule written twice.
+    constexpr bool SameRule(std::uint32_t p, std::uint32_t q) const {
+        return lhs_[p] == lhs_[q] && rhs_length_[p] == rhs_length_[q] &&
+               std::equal(rhs_[p].begin(), rhs_[p].begin() + rhs_length_[p],
+                          rhs_[q].begin());
+    }
+
+    std::array<std::string_view, MAX_SYMBOLS> names_{};
+    std::array<bool, MAX_SYMBOLS>             terminal_{};
+    /// @brief Terminal or non-terminal index of each symbol.
+    std::array<std::uint32_t, MAX_SYMBOLS> kind_index_{};
+    std::array<std::uint32_t, MAX_SYMBOLS> terminal_ids_{};
+    std::array<std::uint32_t, MAX_SYMBOLS> non_terminal_ids_{};
+    std::size_t                            symbol_count_{0};
+    std::size_t                            terminal_count_{0};
+    std::size_t                            non_terminal_count_{0};
+
+    /// @brief The symbol S of S → A $.
+    std::uint32_t axiom_{NO_SYMBOL};
+
+    /// @brief Productions, in the order of the rules and S → A $ last.
+    std::array<std::uint32_t, MAX_PRODUCTIONS>                      lhs_{};
+    std::array<std::array<std::uint32_t, MaxRhs>, MAX_PRODUCTIONS> rhs_{};
+    std::array<std::uint32_t, MAX_PRODUCTIONS> rhs_length_{};
+    std::size_t                                production_count_{0};
+
+    /// @brief FIRST and FOLLOW of each symbol, by SymbolId.
+    std::array<Terminals, MAX_SYMBOLS> first_{};
+    std::array<Terminals, MAX_SYMBOLS> follow_{};
+
+  private:
+    constexpr std::uint32_t Intern(std::string_view name) {
+        std::uint32_t id = GetId(name);
+        if (id != NO_SYMBOL) {
+            return id;
+        }
+        id             = static_cast<std::uint32_t>(symbol_count_++);
+        bool terminal  = name == "$" || name == "EPSILON" ||
+                         (name.front() >= 'a' && name.front() <= 'z');
+        names_[id]     = name;
+        terminal_[id]  = terminal;
+        if (terminal) {
+            kind_index_[id]                  = terminal_count_;
+            terminal_ids_[terminal_count_++] = id;
+        } else {
+            kind_index_[id]                          = non_terminal_count_;
+            non_terminal_ids_[non_terminal_count_++] = id;
+        }
+        return id;
+    }
+
+    /// @brief Adds from to to, returning whether to grew.
+    static constexpr bool Merge(Terminals& to, const Terminals& from) {
+        bool grown = false;
+        for (std::size_t t = 0; t < MAX_SYMBOLS; ++t) {
+            grown |= from[t] && !to[t];
+            to[t] = to[t] || from[t];
+        }
+        return grown;
+    }
+
+    constexpr void ComputeFirst() {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (std::uint32_t p = 0; p < production_count_; ++p) {
+                Terminals first{};
+                first[EPSILON_INDEX] = SuffixFirst(p, 0, first);
+                changed |= Merge(first_[lhs_[p]], first);
+            }
+        }
+    }
+
+    constexpr void ComputeFollow() {
+        follow_[axiom_][EOL_INDEX] = true;
+        bool changed               = true;
+        while (changed) {
+            changed = false;
+            for (std::uint32_t p = 0; p < production_count_; ++p) {
+                for (std::uint32_t i = 0; i < rhs_length_[p]; ++i) {
+                    std::uint32_t symbol = rhs_[p][i];
+                    if (terminal_[symbol]) {
+                        continue;
+                    }
+                    Terminals rest{};
+                    bool      nullable = SuffixFirst(p, i + 1, rest);
+                    changed |= Merge(follow_[symbol], rest);
+                    if (nullable && symbol != lhs_[p]) {
+                        changed |= Merge(follow_[symbol], follow_[lhs_[p]]);
+                    }
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @class StaticLL1Table
+ * @brief LL(1) table of a StaticGrammar, built by a `constexpr` constructor,
+ * with the predictive parser of LL1Parser::Parse.
+ *
+ * As in LL1Parser::CreateLL1Table, a conflicting cell keeps its first
+ * production and is counted in conflicts_. MakeStaticLL1Table turns
+ * conflicts into a compile error.
+ */
+template <std::size_t Rules, std::size_t MaxRhs>
+class StaticLL1Table {
+  public:
+    using GrammarType = StaticGrammar<Rules, MaxRhs>;
+
+    static constexpr std::uint32_t NO_PRODUCTION = 0xffffffff;
+
+    constexpr explicit StaticLL1Table(const GrammarType& gr) : gr_(gr) {
+        for (auto& row : table_) {
+            row.fill(NO_PRODUCTION);
+        }
+        for (std::uint32_t p = 0; p < gr_.production_count_; ++p) {
+            typename GrammarType::Terminals prediction =
+                gr_.PredictionSymbols(p);
+            auto& row = table_[gr_.NonTerminalIndex(gr_.lhs_[p])];
+            for (std::size_t t = 0; t < gr_.terminal_count_; ++t) {
+                if (!prediction[t]) {
+                    continue;
+                }
+                if (row[t] != NO_PRODUCTION) {
+                    ++conflicts_;
+                } else {
+                    row[t] = p;
+                }
+            }
+        }
+    }
+
+    /// @brief Production predicted for a non-terminal and a terminal index,
+    /// or NO_PRODUCTION.
+    constexpr std::uint32_t ProductionAt(std::uint32_t non_terminal,
+                                         std::uint32_t terminal) const {
+        return table_[gr_.NonTerminalIndex(non_terminal)][terminal];
+    }
+
+    /**
+     * @brief Parses a sequence of terminal indices, as LL1Parser::Parse
+     * does with SymbolIds, without the expected terminals.
+     *
+     * @param tokens Random-access range of terminal indices.
+     * @param stack Vector-like container of std::uint32_t used as the
+     * symbol stack. It is cleared first.
+     * @param on_predict Called with the id of each production applied.
+     */
+    template <typename Tokens, typename Stack,
+              typename OnPredict = IgnoreProductions>
+    constexpr StaticParseResult Parse(const Tokens& tokens, Stack& stack,
+                                      OnPredict&& on_predict = {}) const {
+        const std::size_t size     = std::size(tokens);
+        const std::size_t length   = size + 1;
+        std::size_t       position = 0;
+        stack.clear();
+        stack.push_back(gr_.axiom_);
+        while (!stack.empty()) {
+            std::uint32_t token =
+                position < size
+                    ? static_cast<std::uint32_t>(std::begin(tokens)[position])
+                    : GrammarType::EOL_INDEX;
+            if (token >= gr_.terminal_count_) {
+                return {false, position};
+            }
+            std::uint32_t top = stack.back();
+            if (gr_.IsTerminal(top)) {
+                if (gr_.TerminalIndex(top) != token || position == length) {
+                    return {false, std::min(position, size)};
+                }
+                stack.pop_back();
+                ++position;
+                continue;
+            }
+            std::uint32_t p = table_[gr_.NonTerminalIndex(top)][token];
+            if (p == NO_PRODUCTION) {
+                return {false, std::min(position, size)};
+            }
+            stack.pop_back();
+            for (std::uint32_t i = gr_.rhs_length_[p]; i-- > 0;) {
+                stack.push_back(gr_.rhs_[p][i]);
+            }
+            on_predict(p);
+        }
+        if (position != length) {
+            return {false, std::min(position, size)};
+        }
+        return {true, 0};
+    }
+
+    /// @brief Parses with a symbol stack of its own, see above.
+    template <typename Tokens>
+    constexpr StaticParseResult Parse(const Tokens& tokens) const {
+        std::vector<std::uint32_t> stack;
+        return Parse(tokens, stack);
+    }
+
+    GrammarType gr_;
+
+    /// @brief Productions by non-terminal index and terminal index.
+    std::array<std::array<std::uint32_t, GrammarType::MAX_SYMBOLS>,
+               GrammarType::MAX_SYMBOLS>
+        table_{};
+
+    /// @brief Number of cells predicted by more than one production.
+    std::size_t conflicts_{0};
+};
+
+/**
+ * @class StaticSLR1Table
+ * @brief LR(0) automaton and SLR(1) tables of a StaticGrammar, built by a
+ * `constexpr` constructor, with the parser of SLR1Parser::Parse.
+ *
+ * The grammar is augmented with S' → S, which is not one of its
+ * productions: accepting stands for reducing by it, and it takes the id
+ * production_count_, as in an augmented Grammar. States are numbered as
+ * SLR1Parser::MakeAutomaton numbers them, and actions use the packing of
+ * SLR1Parser::PackAction. Conflicts are resolved like
+ * SLR1Parser::AddItemActions resolves them, keeping the first action, and
+ * counted in conflicts_. MakeStaticSLR1Table turns conflicts into a compile
+ * error.
+ */
+template <std::size_t Rules, std::size_t MaxRhs>
+class StaticSLR1Table {
+  public:
+    using GrammarType = StaticGrammar<Rules, MaxRhs>;
+
+    /// @brief Every item of every production, S' → S included.
+    static constexpr std::size_t MAX_ITEMS =
+        (GrammarType::MAX_PRODUCTIONS + 1) * (MaxRhs + 1);
+    static constexpr std::size_t MAX_STATES = 2 * MAX_ITEMS;
+
+    static constexpr std::uint32_t EMPTY_ACTION = 0;
+    static constexpr std::uint32_t SHIFT        = 1;
+    static constexpr std::uint32_t REDUCE       = 2;
+    static constexpr std::uint32_t ACCEPT       = 3;
+    static constexpr std::uint32_t NO_STATE     = 0xffffffff;
+
+    static constexpr std::uint32_t PackAction(std::uint32_t kind,
+                                              std::uint32_t target) {
+        return kind << 30 | target;
+    }
+    static constexpr std::uint32_t ActionKind(std::uint32_t action) {
+        return action >> 30;
+    }
+    static constexpr std::uint32_t ActionTarget(std::uint32_t action) {
+        return action & ((std::uint32_t{1} << 30) - 1);
+    }
+
+    /// @brief Set of items, by item index.
+    using Items = std::array<bool, MAX_ITEMS>;
+
+    /**
+     * @brief Builds the automaton and the tables.
+     *
+     * @throw std::length_error if the automaton has more than MAX_STATES
+     * states; in a constant expression, this is a compile error.
+     */
+    constexpr explicit StaticSLR1Table(const GrammarType& gr) : gr_(gr) {
+        // Item numbering: the items of production p start at item_offset_[p]
+        std::size_t items = 0;
+        for (std::uint32_t p = 0; p <= gr_.production_count_; ++p) {
+            item_offset_[p] = static_cast<std::uint32_t>(items);
+            for (std::uint32_t dot = 0; dot <= Length(p); ++dot) {
+                item_production_[items] = p;
+                item_dot_[items]        = dot;
+                ++items;
+            }
+        }
+        item_count_ = items;
+        for (auto& row : actions_) {
+            row.fill(EMPTY_ACTION);
+        }
+        for (auto& row : gotos_) {
+            row.fill(NO_STATE);
+        }
+
+        kernels_[0][item_offset_[gr_.production_count_]] = true;
+        state_count_                                      = 1;
+        for (std::uint32_t current = 0; current < state_count_; ++current) {
+            Items closure = Closure(kernels_[current]);
+            // Symbols in the order of their ids, as in MakeAutomaton
+            for (std::uint32_t symbol = 0; symbol < gr_.symbol_count_;
+                 ++symbol) {
+                Items kernel{};
+                bool  any = false;
+                for (std::size_t i = 0; i < item_count_; ++i) {
+                    if (closure[i] && NextToDot(i) == symbol) {
+                        kernel[i + 1] = true;
+                        any           = true;
+                    }
+                }
+                if (!any) {
+                    continue;
+                }
+                std::uint32_t to = 0;
+                while (to < state_count_ && kernels_[to] != kernel) {
+                    ++to;
+                }
+                if (to == state_count_) {
+                    if (state_count_ == MAX_STATES) {
+                        throw std::length_error(
+                            "StaticSLR1Table: too many states");
+                    }
+                    kernels_[state_count_++] = kernel;
+                }
+                if (gr_.IsTerminal(symbol)) {
+                    actions_[current][gr_.TerminalIndex(symbol)] =
+                        PackAction(SHIFT, to);
+                } else {
+                    gotos_[current][gr_.NonTerminalIndex(symbol)] = to;
+                }
+            }
+        }
+
+        for (std::uint32_t s = 0; s < state_count_; ++s) {
+            Items closure = Closure(kernels_[s]);
+            for (std::size_t i = 0; i < item_count_; ++i) {
+                if (closure[i] && NextToDot(i) == GrammarType::NO_SYMBOL) {
+                    AddReduction(s, item_production_[i]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Parses a sequence of terminal indices, as SLR1Parser::Parse
+     * does with SymbolIds.
+     *
+     * @param tokens Random-access range of terminal indices.
+     * @param stack Vector-like container of std::uint32_t used as the state
+     * stack. It is cleared first.
+     * @param on_reduce Called with the id of each production reduced by,
+     * and with that of S' → S on acceptance: a rightmost derivation in
+     * reverse.
+     */
+    template <typename Tokens, typename Stack,
+              typename OnReduce = IgnoreProductions>
+    constexpr StaticParseResult Parse(const Tokens& tokens, Stack& stack,
+                                      OnReduce&& on_reduce = {}) const {
+        const std::size_t size     = std::size(tokens);
+        const std::size_t length   = size + 1;
+        std::size_t       position = 0;
+        stack.clear();
+        stack.push_back(0);
+        while (true) {
+            std::uint32_t token =
+                position < size
+                    ? static_cast<std::uint32_t>(std::begin(tokens)[position])
+                    : GrammarType::EOL_INDEX;
+            if (token >= gr_.terminal_count_) {
+                return {false, position};
+            }
+            std::uint32_t action = actions_[stack.back()][token];
+            std::uint32_t target = ActionTarget(action);
+            switch (ActionKind(action)) {
+            case SHIFT:
+                if (position == length) {
+                    return {false, size};
+                }
+                stack.push_back(target);
+                ++position;
+                break;
+            case REDUCE:
+                stack.resize(stack.size() - gr_.rhs_length_[target]);
+                stack.push_back(
+                    gotos_[stack.back()]
+                          [gr_.NonTerminalIndex(gr_.lhs_[target])]);
+                on_reduce(target);
+                break;
+            case ACCEPT:
+                if (position != length) {
+                    return {false, position};
+                }
+                on_reduce(target);
+                return {true, 0};
+            default:
+                return {false, std::min(position, size)};
+            }
+        }
+    }
+
+    /// @brief Parses with a state stack of its own, see above.
+    template <typename Tokens>
+    constexpr StaticParseResult Parse(const Tokens& tokens) const {
+        std::vector<std::uint32_t> stack;
+        return Parse(tokens, stack);
+    }
+
+    GrammarType gr_;
+
+    /// @brief Kernel of each state.
+    std::array<Items, MAX_STATES> kernels_{};
+    std::size_t                   state_count_{0};
+
+    /// @brief ACTION by state and terminal index, GOTO by state and
+    /// non-terminal index.
+    std::array<std::array<std::uint32_t, GrammarType::MAX_SYMBOLS>, MAX_STATES>
+        actions_{};
+    std::array<std::array<std::uint32_t, GrammarType::MAX_SYMBOLS>, MAX_STATES>
+        gotos_{};
+
+    /// @brief Number of cells where a second action was rejected.
+    std::size_t conflicts_{0};
+
+  private:
+    /// @brief Length of production p; p == production_count_ is S' → S.
+    constexpr std::uint32_t Length(std::uint32_t p) const {
+        return p == gr_.production_count_ ? 1 : gr_.rhs_length_[p];
+    }
+
+    /// @brief Symbol after the dot of an item, or NO_SYMBOL if complete.
+    constexpr std::uint32_t NextToDot(std::size_t item) const {
+        std::uint32_t p   = item_production_[item];
+        std::uint32_t dot = item_dot_[item];
+        if (dot == Length(p)) {
+            return GrammarType::NO_SYMBOL;
+        }
+        return p == gr_.production_count_ ? gr_.axiom_ : gr_.rhs_[p][dot];
+    }
+
+    constexpr Items Closure(const Items& kernel) const {
+        Items closure = kernel;
+        bool  changed = true;
+        while (changed) {
+            changed = false;
+            for (std::size_t i = 0; i < item_count_; ++i) {
+                std::uint32_t next = closure[i] ? NextToDot(i)
+                                                : GrammarType::NO_SYMBOL;
+                if (next == GrammarType::NO_SYMBOL || gr_.IsTerminal(next)) {
+                    continue;
+                }
+                for (std::uint32_t p = 0; p < gr_.production_count_; ++p) {
+                    if (gr_.lhs_[p] == next && !closure[item_offset_[p]]) {
+                        closure[item_offset_[p]] = true;
+                        changed                  = true;
+                    }
+                }
+            }
+        }
+        return closure;
+    }
+
+    /// @brief Adds the actions of a complete item of production p.
+    constexpr void AddReduction(std::uint32_t state, std::uint32_t p) {
+        auto& row = actions_[state];
+        if (p == gr_.production_count_) {
+            if (ActionKind(row[GrammarType::EOL_INDEX]) == REDUCE) {
+                ++conflicts_;
+            } else {
+                row[GrammarType::EOL_INDEX] = PackAction(ACCEPT, p);
+            }
+            return;
+        }
+        const auto& follow = gr_.follow_[gr_.lhs_[p]];
+        for (std::size_t t = 0; t < gr_.terminal_count_; ++t) {
+            if (!follow[t]) {
+                continue;
+            }
+            if (row[t] == EMPTY_ACTION) {
+                row[t] = PackAction(REDUCE, p);
+            } else if (ActionKind(row[t]) != REDUCE ||
+                       !gr_.SameRule(ActionTarget(row[t]), p)) {
+                ++conflicts_;
+            }
+        }
+    }
+
+    std::array<std::uint32_t, GrammarType::MAX_PRODUCTIONS + 1> item_offset_{};
+    std::array<std::uint32_t, MAX_ITEMS> item_production_{};
+    std::array<std::uint32_t, MAX_ITEMS> item_dot_{};
+    std::size_t                          item_count_{0};
+};
+
+/**
+ * @brief LL(1) table of a `constexpr` StaticGrammar, failing to compile if
+ * the grammar is not LL(1).
+ *
+ * @code
+ * constexpr StaticGrammar gr{{{"A", "a A"}, {"A", "EPSILON"}}};
+ * constexpr auto          ll1 = MakeStaticLL1Table<gr>();
+ * @endcode
+ */
+template <const auto& Gr>
+consteval auto MakeStaticLL1Table() {
+    constexpr StaticLL1Table table(Gr);
+    static_assert(table.conflicts_ == 0, "The grammar is not LL(1)");
+    return table;
+}
+
+/**
+ * @brief SLR(1) tables of a `constexpr` StaticGrammar, failing to compile
+ * if the grammar is not SLR(1).
+ */
+template <const auto& Gr>
+consteval auto MakeStaticSLR1Table() {
+    constexpr StaticSLR1Table table(Gr);
+    static_assert(table.conflicts_ == 0, "The grammar is not SLR(1)");
+    return table;
+}
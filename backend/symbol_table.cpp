@@ -3,29 +3,81 @@
 #include <vector>
 
 void SymbolTable::PutSymbol(const std::string& identifier, bool isTerminal) {
+    SymbolId id = Intern(identifier, isTerminal);
+    std::vector<SymbolId>& same_kind =
+        isTerminal ? terminal_ids_ : non_terminal_ids_;
+    if (id > EPSILON_ID && (kind_index_[id] >= same_kind.size() ||
+                            same_kind[kind_index_[id]] != id)) {
+        ChangeKind(id, isTerminal);
+    }
     if (isTerminal) {
+        terminal_flags_[id] = 1;
         if (identifier == EPSILON_) {
             terminals_.insert(EPSILON_);
             terminals_wtho_eol_.insert(EPSILON_);
             return;
         }
-        st_.insert({identifier, TERMINAL});
         terminals_.insert(identifier);
         terminals_wtho_eol_.insert(identifier);
     } else {
-        st_.insert({identifier, NO_TERMINAL});
+        non_terminal_flags_[id] = 1;
         non_terminals_.insert(identifier);
     }
 }
 
+SymbolId SymbolTable::Intern(const std::string& identifier, bool isTerminal) {
+    auto [it, inserted] =
+        ids_.try_emplace(identifier, static_cast<SymbolId>(names_.size()));
+    if (inserted) {
+        names_.push_back(identifier);
+        terminal_flags_.push_back(isTerminal ? 1 : 0);
+        non_terminal_flags_.push_back(isTerminal ? 0 : 1);
+        std::vector<SymbolId>& same_kind =
+            isTerminal ? terminal_ids_ : non_terminal_ids_;
+        kind_index_.push_back(static_cast<std::uint32_t>(same_kind.size()));
+        same_kind.push_back(it->second);
+    }
+    return it->second;
+}
+
+void SymbolTable::ChangeKind(SymbolId id, bool isTerminal) {
+    std::vector<SymbolId>& old_kind =
+        isTerminal ? non_terminal_ids_ : terminal_ids_;
+    std::vector<SymbolId>& new_kind =
+        isTerminal ? terminal_ids_ : non_terminal_ids_;
+
+    // The symbols after it move down one place among those of the old kind
+    old_kind.erase(old_kind.begin() + kind_index_[id]);
+    for (std::uint32_t i = kind_index_[id]; i < old_kind.size(); ++i) {
+        kind_index_[old_kind[i]] = i;
+    }
+    kind_index_[id] = static_cast<std::uint32_t>(new_kind.size());
+    new_kind.push_back(id);
+
+    if (isTerminal) {
+        non_terminal_flags_[id] = 0;
+        non_terminals_.erase(names_[id]);
+    } else {
+        terminal_flags_[id] = 0;
+        terminals_.erase(names_[id]);
+        terminals_wtho_eol_.erase(names_[id]);
+    }
+}
+
+SymbolId SymbolTable::GetId(const std::string& s) const {
+    auto it = ids_.find(s);
+    return it != ids_.cend() ? it->second : NO_SYMBOL;
+}
+
 bool SymbolTable::In(const std::string& s) {
-    return st_.find(s) != st_.cend();
+    return ids_.find(s) != ids_.cend();
 }
 
 bool SymbolTable::IsTerminal(const std::string& s) {
-    return terminals_.find(s) != terminals_.end();
+    SymbolId id = GetId(s);
+    return id != NO_SYMBOL && IsTerminal(id);
 }
 
 bool SymbolTable::IsTerminalWthoEol(const std::string& s) {
-    return s != EPSILON_ && terminals_.find(s) != terminals_.end();
+    return s != EPSILON_ && IsTerminal(s);
 }
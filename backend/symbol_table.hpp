@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -7,7 +8,25 @@
 
 enum symbol_type { NO_TERMINAL, TERMINAL };
 
+/// @brief Dense integer identifier of an interned grammar symbol.
+using SymbolId = std::uint32_t;
+
 struct SymbolTable {
+    /// @brief Fixed id of the end-of-line symbol.
+    static constexpr SymbolId EOL_ID = 0;
+
+    /// @brief Fixed id of the epsilon symbol.
+    static constexpr SymbolId EPSILON_ID = 1;
+
+    /// @brief Terminal index of the end-of-line symbol.
+    static constexpr std::uint32_t EOL_INDEX = 0;
+
+    /// @brief Terminal index of the epsilon symbol.
+    static constexpr std::uint32_t EPSILON_INDEX = 1;
+
+    /// @brief Returned by GetId when a name has not been interned.
+    static constexpr SymbolId NO_SYMBOL = static_cast<SymbolId>(-1);
+
     /// @brief End-of-line symbol used in parsing, initialized as "$".
     std::string EOL_{"$"};
 
@@ -15,10 +34,30 @@ struct SymbolTable {
     /// "EPSILON".
     std::string EPSILON_{"EPSILON"};
 
-    /// @brief Main symbol table, mapping identifiers to a pair of symbol type
-    /// and its regex.
-    std::unordered_map<std::string, symbol_type> st_{{EOL_, TERMINAL},
-                                                     {EPSILON_, TERMINAL}};
+    /// @brief Maps every interned identifier to its SymbolId.
+    std::unordered_map<std::string, SymbolId> ids_{{EOL_, EOL_ID},
+                                                   {EPSILON_, EPSILON_ID}};
+
+    /// @brief Symbol names indexed by SymbolId, used for display.
+    std::vector<std::string> names_{EOL_, EPSILON_};
+
+    /// @brief Terminal flag per SymbolId. EPSILON is only flagged once it has
+    /// been put as a terminal, mirroring terminals_.
+    std::vector<std::uint8_t> terminal_flags_{1, 0};
+
+    /// @brief Non-terminal flag per SymbolId.
+    std::vector<std::uint8_t> non_terminal_flags_{0, 0};
+
+    /// @brief Position of each symbol among the symbols of its own kind.
+    /// Terminals are numbered from 0 (EOL) and 1 (EPSILON), non-terminals
+    /// from 0, so per-terminal data can be stored densely.
+    std::vector<std::uint32_t> kind_index_{0, 1};
+
+    /// @brief SymbolIds of the terminals, by terminal index.
+    std::vector<SymbolId> terminal_ids_{EOL_ID, EPSILON_ID};
+
+    /// @brief SymbolIds of the non-terminals, by non-terminal index.
+    std::vector<SymbolId> non_terminal_ids_;
 
     std::unordered_set<std::string> terminals_{EOL_};
     std::unordered_set<std::string> terminals_wtho_eol_{};
@@ -27,11 +66,55 @@ struct SymbolTable {
     /**
      * @brief Adds a non-terminal symbol to the symbol table.
      *
+     * A symbol that was interned with the other kind, such as an unknown
+     * symbol Grammar interned as a non-terminal, changes kind.
+     *
      * @param identifier Name of the  symbol.
      * @param isTerminal True if the identifier is a terminal symbol
      */
     void PutSymbol(const std::string& identifier, bool isTerminal);
 
+    /**
+     * @brief Moves an interned symbol to the other kind: it gets the next
+     * index of its new kind, and the symbols after it in its old kind move
+     * down one index. EOL and EPSILON keep their fixed indices, so they must
+     * not be moved.
+     *
+     * @param id SymbolId of the symbol.
+     * @param isTerminal True if the symbol becomes a terminal.
+     */
+    void ChangeKind(SymbolId id, bool isTerminal);
+
+    /**
+     * @brief Returns the id of a symbol, assigning a new one if the symbol has
+     * not been seen before. Unlike PutSymbol, the string sets are left
+     * untouched.
+     *
+     * @param identifier Name of the symbol.
+     * @param isTerminal True if the identifier is a terminal symbol.
+     * @return The SymbolId of the identifier.
+     */
+    SymbolId Intern(const std::string& identifier, bool isTerminal);
+
+    /**
+     * @brief Looks up the id of an interned symbol.
+     *
+     * @param s Symbol identifier to search.
+     * @return Its SymbolId, or NO_SYMBOL if it is not in the table.
+     */
+    SymbolId GetId(const std::string& s) const;
+
+    /**
+     * @brief Returns the name of an interned symbol.
+     *
+     * @param id SymbolId of the symbol.
+     * @return The identifier the symbol was interned with.
+     */
+    const std::string& Name(SymbolId id) const { return names_[id]; }
+
+    /// @brief Number of interned symbols; every valid SymbolId is below it.
+    std::size_t Size() const { return names_.size(); }
+
     /**
      * @brief Checks if a symbol exists in the symbol table.
      *
@@ -55,4 +138,20 @@ struct SymbolTable {
      * @return true if the symbol is terminal, otherwise false.
      */
     bool IsTerminalWthoEol(const std::string& s);
+
+    /// @brief Dense index of a terminal among terminals.
+    std::uint32_t TerminalIndex(SymbolId id) const { return kind_index_[id]; }
+
+    /// @brief Dense index of a non-terminal among non-terminals.
+    std::uint32_t NonTerminalIndex(SymbolId id) const {
+        return kind_index_[id];
+    }
+
+    /// @brief Checks if an interned symbol is a terminal.
+    bool IsTerminal(SymbolId id) const { return terminal_flags_[id] != 0; }
+
+    /// @brief Checks if an interned symbol is a non-terminal.
+    bool IsNonTerminal(SymbolId id) const {
+        return non_terminal_flags_[id] != 0;
+    }
 };
@@ -0,0 +1,38 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "symbol_table.hpp"
+#include "symbol_trie.hpp"
+
+SymbolTrie::SymbolTrie(const SymbolTable& st) : symbol_count_(st.Size()) {
+    column_.fill(NO_COLUMN);
+    for (const std::string& name : st.names_) {
+        for (char c : name) {
+            std::uint32_t& column = column_[static_cast<unsigned char>(c)];
+            if (column == NO_COLUMN) {
+                column = static_cast<std::uint32_t>(columns_++);
+            }
+        }
+    }
+
+    next_.assign(columns_, 0);
+    symbol_.assign(1, SymbolTable::NO_SYMBOL);
+    for (SymbolId id = 0; id < st.Size(); ++id) {
+        std::uint32_t node = 0;
+        for (char c : st.Name(id)) {
+            std::size_t cell =
+                node * columns_ + column_[static_cast<unsigned char>(c)];
+            if (next_[cell] == 0) {
+                next_[cell] = static_cast<std::uint32_t>(symbol_.size());
+                next_.resize(next_.size() + columns_, 0);
+                symbol_.push_back(SymbolTable::NO_SYMBOL);
+            }
+            node = next_[cell];
+        }
+        if (node != 0) {
+            symbol_[node] = id;
+        }
+    }
+}
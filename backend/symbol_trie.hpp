@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "symbol_table.hpp"
+
+/**
+ * @class SymbolTrie
+ * @brief Trie over the names of every symbol of a SymbolTable, used to split
+ * strings written without separators into symbols.
+ *
+ * The trie is stored as a DFA table, one row per node and one column per
+ * distinct byte found in the names, so each step costs two array lookups.
+ * Every node records the symbol whose name ends there, if any.
+ */
+class SymbolTrie {
+  public:
+    SymbolTrie() = default;
+
+    /// @brief Builds the trie of the names interned in st.
+    explicit SymbolTrie(const SymbolTable& st);
+
+    /**
+     * @brief Splits s into symbols, taking the longest name at each position.
+     *
+     * @param s The string to split.
+     * @param emit Called with the SymbolId of each symbol found, in order.
+     * @return std::string::npos if the whole string was split, otherwise the
+     * offset of the first character no name starts with. The symbols before
+     * it have been emitted.
+     */
+    template <typename F>
+    std::size_t Split(std::string_view s, F&& emit) const {
+        std::size_t start = 0;
+        while (start < s.size()) {
+            std::uint32_t node  = 0;
+            SymbolId      found = SymbolTable::NO_SYMBOL;
+            std::size_t   end   = start;
+            for (std::size_t i = start; i < s.size(); ++i) {
+                std::uint32_t column =
+                    column_[static_cast<unsigned char>(s[i])];
+                if (column == NO_COLUMN) {
+                    break;
+                }
+                node = next_[node * columns_ + column];
+                if (node == 0) {
+                    break;
+                }
+                if (symbol_[node] != SymbolTable::NO_SYMBOL) {
+                    found = symbol_[node];
+                    end   = i + 1;
+                }
+            }
+            if (found == SymbolTable::NO_SYMBOL) {
+                return start;
+            }
+            emit(found);
+            start = end;
+        }
+        return std::string::npos;
+    }
+
+    /// @brief Number of symbols of the table the trie was built from.
+    std::size_t SymbolCount() const { return symbol_count_; }
+
+  private:
+    /// @brief Marks a byte that no name contains in column_.
+    static constexpr std::uint32_t NO_COLUMN = static_cast<std::uint32_t>(-1);
+
+    /// @brief Column of each byte value in next_.
+    std::array<std::uint32_t, 256> column_{};
+
+    /// @brief Number of columns of next_.
+    std::size_t columns_{0};
+
+    /// @brief Child of each node for each column, row-major. The root is node
+    /// 0, which is never a child, so 0 also stands for no child.
+    std::vector<std::uint32_t> next_;
+
+    /// @brief Symbol whose name ends at each node, or NO_SYMBOL.
+    std::vector<SymbolId> symbol_;
+
+    std::size_t symbol_count_{0};
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+#include "bitset.hpp"
+#include "symbol_table.hpp"
+
+/**
+ * @brief Set of terminals stored as a bitset over terminal indices (see
+ * SymbolTable::TerminalIndex).
+ *
+ * Used for FIRST and FOLLOW sets. EPSILON has its own terminal index, so a
+ * FIRST set marks nullability by containing it.
+ */
+class TerminalSet : public BitSet {
+  public:
+    using BitSet::BitSet;
+
+    /**
+     * @brief Converts the set to the terminal names used by the GUI.
+     */
+    std::unordered_set<std::string> ToStrings(const SymbolTable& st) const {
+        std::unordered_set<std::string> result;
+        ForEach([&](std::uint32_t index) {
+            result.insert(st.Name(st.terminal_ids_[index]));
+        });
+        return result;
+    }
+};
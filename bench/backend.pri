@@ -0,0 +1,25 @@
+# Backend sources shared by the benchmarks and the self-checks. They do not
+# depend on Qt.
+CONFIG += console c++20 release
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += $$PWD/../backend
+
+SOURCES += \
+    $$PWD/../backend/compressed_table.cpp \
+    $$PWD/../backend/grammar.cpp \
+    $$PWD/../backend/grammar_analysis.cpp \
+    $$PWD/../backend/grammar_factory.cpp \
+    $$PWD/../backend/lalr1_parser.cpp \
+    $$PWD/../backend/ll1_parser.cpp \
+    $$PWD/../backend/lr0_item.cpp \
+    $$PWD/../backend/lr1_parser.cpp \
+    $$PWD/../backend/parser_emitter.cpp \
+    $$PWD/../backend/parser_image.cpp \
+    $$PWD/../backend/slr1_parser.cpp \
+    $$PWD/../backend/slr1_recognizer.cpp \
+    $$PWD/../backend/symbol_table.cpp \
+    $$PWD/../backend/symbol_trie.cpp
+
+HEADERS += \
+    $$PWD/bench.hpp
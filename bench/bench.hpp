@@ -0,0 +1,165 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "grammar.hpp"
+#include "symbol_table.hpp"
+
+/// @brief Rules of a grammar, as taken by the Grammar constructor.
+using Rules = std::unordered_map<std::string, std::vector<production>>;
+
+/**
+ * @brief Arithmetic expressions with calls, in LL(1) form. The grammar is
+ * SLR(1) too, so every parser can be measured on it.
+ */
+inline const Rules EXPRESSIONS = {
+    {"A", {{"T", "X"}}},
+    {"X", {{"plus", "T", "X"}, {"minus", "T", "X"}, {"EPSILON"}}},
+    {"T", {{"F", "Y"}}},
+    {"Y", {{"times", "F", "Y"}, {"div", "F", "Y"}, {"EPSILON"}}},
+    {"F", {{"lpar", "A", "rpar"}, {"num"}, {"id", "Z"}}},
+    {"Z", {{"lpar", "L", "rpar"}, {"EPSILON"}}},
+    {"L", {{"A", "M"}, {"EPSILON"}}},
+    {"M", {{"comma", "A", "M"}, {"EPSILON"}}},
+};
+
+/**
+ * @brief Statements and left-recursive expressions of a small imperative
+ * language. It is LALR(1) and has more states than EXPRESSIONS, to measure
+ * the construction of the LR tables.
+ */
+inline const Rules STATEMENTS = {
+    {"A", {{"B"}}},
+    {"B", {{"B", "D"}, {"D"}}},
+    {"D",
+     {{"id", "assign", "E", "semi"},
+      {"id", "lbrack", "E", "rbrack", "assign", "E", "semi"},
+      {"id", "lpar", "R", "rpar", "semi"},
+      {"while", "lpar", "E", "rpar", "D"},
+      {"lbrace", "B", "rbrace"},
+      {"print", "E", "semi"}}},
+    {"R", {{"R", "comma", "E"}, {"E"}}},
+    {"E", {{"E", "or", "C"}, {"C"}}},
+    {"C", {{"C", "and", "Q"}, {"Q"}}},
+    {"Q", {{"K", "eq", "K"}, {"K", "lt", "K"}, {"K"}}},
+    {"K", {{"K", "plus", "T"}, {"K", "minus", "T"}, {"T"}}},
+    {"T", {{"T", "times", "U"}, {"T", "div", "U"}, {"U"}}},
+    {"U", {{"minus", "U"}, {"not", "U"}, {"P"}}},
+    {"P",
+     {{"lpar", "E", "rpar"},
+      {"num"},
+      {"id"},
+      {"id", "lpar", "R", "rpar"},
+      {"id", "lbrack", "E", "rbrack"}}},
+};
+
+/// @brief Depth from which Sentences only closes derivations.
+inline constexpr std::uint32_t MAX_DEPTH = 10;
+
+/**
+ * @brief Random sentences derived from A, the start symbol, without the EOL
+ * that closes the axiom: the tokens Parse takes.
+ *
+ * Productions are picked uniformly until a derivation is MAX_DEPTH deep;
+ * deeper, only those with the lowest derivation trees are, so every
+ * sentence ends. The same seed gives the same sentences.
+ */
+inline std::vector<std::vector<SymbolId>>
+Sentences(const Grammar& gr, std::size_t count, unsigned int seed = 1) {
+    const ProductionStore& store = gr.store_;
+    const SymbolTable&     st    = gr.st_;
+
+    constexpr std::uint32_t UNKNOWN = std::numeric_limits<std::uint32_t>::max();
+
+    // Height of the lowest derivation tree of each symbol
+    std::vector<std::uint32_t> height(st.Size(), UNKNOWN);
+    auto production_height = [&](ProductionId p) {
+        std::uint32_t h = 0;
+        for (SymbolId symbol : store.Rhs(p)) {
+            h = std::max(h, height[symbol]);
+        }
+        return h == UNKNOWN ? UNKNOWN : h + 1;
+    };
+    for (SymbolId id = 0; id < st.Size(); ++id) {
+        if (st.IsTerminal(id)) {
+            height[id] = 0;
+        }
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (ProductionId p = 0; p < store.Size(); ++p) {
+            std::uint32_t h = production_height(p);
+            if (h < height[store.Lhs(p)]) {
+                height[store.Lhs(p)] = h;
+                changed              = true;
+            }
+        }
+    }
+
+    std::mt19937              rng(seed);
+    std::vector<ProductionId> candidates;
+    auto derive = [&](auto& self, SymbolId symbol, std::uint32_t depth,
+                      std::vector<SymbolId>& out) -> void {
+        if (st.IsTerminal(symbol)) {
+            out.push_back(symbol);
+            return;
+        }
+        candidates.clear();
+        for (ProductionId p = store.Begin(symbol); p < store.End(symbol);
+             ++p) {
+            if (depth < MAX_DEPTH || production_height(p) == height[symbol]) {
+                candidates.push_back(p);
+            }
+        }
+        ProductionId p = candidates[rng() % candidates.size()];
+        for (SymbolId next : store.Rhs(p)) {
+            self(self, next, depth + 1, out);
+        }
+    };
+
+    std::vector<std::vector<SymbolId>> sentences(count);
+    for (std::vector<SymbolId>& sentence : sentences) {
+        derive(derive, st.GetId("A"), 0, sentence);
+    }
+    return sentences;
+}
+
+/// @brief Number of tokens of all the sentences.
+template <typename Token>
+std::size_t TokenCount(const std::vector<std::vector<Token>>& sentences) {
+    std::size_t tokens = 0;
+    for (const std::vector<Token>& sentence : sentences) {
+        tokens += sentence.size();
+    }
+    return tokens;
+}
+
+/// @brief Time TimePerCall spends on each measurement, at least.
+inline constexpr double MIN_SECONDS = 0.25;
+
+/**
+ * @brief Mean time of one call of f, in seconds. f is called at least once,
+ * and again until MIN_SECONDS have passed.
+ */
+template <typename F> double TimePerCall(F&& f) {
+    using Clock = std::chrono::steady_clock;
+
+    const Clock::time_point start = Clock::now();
+    std::size_t             calls = 0;
+    double                  elapsed;
+    do {
+        f();
+        ++calls;
+        elapsed =
+            std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < MIN_SECONDS);
+    return elapsed / static_cast<double>(calls);
+}
@@ -0,0 +1,8 @@
+# Benchmarks and self-checks of the backend, built apart from SyntaxTutor.pro:
+#   qmake bench/bench.pro && make && ./self_check && ./parsers && ./parse_batch
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    parse_batch.pro \
+    parsers.pro \
+    self_check.pro
@@ -0,0 +1,325 @@
+// Parser generated by SyntaxTutor. Do not edit.
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace expressions_descent {
+
+inline constexpr std::uint32_t TERMINAL_COUNT     = 11;
+inline constexpr std::uint32_t NON_TERMINAL_COUNT = 9;
+inline constexpr std::uint32_t PRODUCTION_COUNT   = 18;
+
+/// @brief Terminal index of the end of the input.
+inline constexpr std::uint32_t EOL_INDEX = 0;
+
+/// @brief Names of the terminals, by terminal index.
+inline constexpr std::string_view TERMINAL_NAMES[] = {
+    "$",
+    "EPSILON",
+    "comma",
+    "lpar",
+    "rpar",
+    "num",
+    "id",
+    "times",
+    "div",
+    "plus",
+    "minus",
+};
+
+/// @brief Terminal index of a name, or TERMINAL_COUNT if there is none.
+constexpr std::uint32_t FindTerminal(std::string_view terminal) {
+    for (std::uint32_t i = 0; i < TERMINAL_COUNT; ++i) {
+        if (TERMINAL_NAMES[i] == terminal) {
+            return i;
+        }
+    }
+    return TERMINAL_COUNT;
+}
+
+/// @brief Outcome of Parse.
+struct ParseResult {
+    bool        accepted;
+    std::size_t error_position;
+};
+
+/// @brief Prediction callback of Parse that does nothing.
+struct IgnorePredictions {
+    constexpr void operator()(std::uint32_t) const {}
+};
+
+/// @brief Recursive-descent parser, one member function per non-terminal.
+template <typename Tokens, typename OnPredict>
+struct Parser {
+    const Tokens& tokens;
+    std::size_t   size;
+    std::size_t   position;
+    OnPredict&    on_predict;
+
+    /// @brief Terminal index of the lookahead, EOL past the last token.
+    std::uint32_t Token() const {
+        return position < size
+                   ? static_cast<std::uint32_t>(std::begin(tokens)[position])
+                   : EOL_INDEX;
+    }
+
+    /// @brief Reads the lookahead if it is `terminal`. Nothing can be read
+    /// at the end marker after the closing EOL.
+    bool Match(std::uint32_t terminal) {
+        if (Token() != terminal || position == size + 1) {
+            return false;
+        }
+        ++position;
+        return true;
+    }
+
+    /// @brief M.
+    bool NonTerminal0() {
+        switch (Token()) {
+        case 2:
+            // M -> comma A M
+            on_predict(0);
+            if (!Match(2)) {
+                return false;
+            }
+            if (!NonTerminal7()) {
+                return false;
+            }
+            return NonTerminal0();
+        case 4:
+            // M -> EPSILON
+            on_predict(1);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /// @brief L.
+    bool NonTerminal1() {
+        switch (Token()) {
+        case 3:
+        case 5:
+        case 6:
+            // L -> A M
+            on_predict(2);
+            if (!NonTerminal7()) {
+                return false;
+            }
+            return NonTerminal0();
+        case 4:
+            // L -> EPSILON
+            on_predict(3);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /// @brief Z.
+    bool NonTerminal2() {
+        switch (Token()) {
+        case 3:
+            // Z -> lpar L rpar
+            on_predict(4);
+            if (!Match(3)) {
+                return false;
+            }
+            if (!NonTerminal1()) {
+                return false;
+            }
+            return Match(4);
+        case 0:
+        case 2:
+        case 4:
+        case 7:
+        case 8:
+        case 9:
+        case 10:
+            // Z -> EPSILON
+            on_predict(5);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /// @brief F.
+    bool NonTerminal3() {
+        switch (Token()) {
+        case 3:
+            // F -> lpar A rpar
+            on_predict(6);
+            if (!Match(3)) {
+                return false;
+            }
+            if (!NonTerminal7()) {
+                return false;
+            }
+            return Match(4);
+        case 5:
+            // F -> num
+            on_predict(7);
+            return Match(5);
+        case 6:
+            // F -> id Z
+            on_predict(8);
+            if (!Match(6)) {
+                return false;
+            }
+            return NonTerminal2();
+        default:
+            return false;
+        }
+    }
+
+    /// @brief Y.
+    bool NonTerminal4() {
+        switch (Token()) {
+        case 7:
+            // Y -> times F Y
+            on_predict(9);
+            if (!Match(7)) {
+                return false;
+            }
+            if (!NonTerminal3()) {
+                return false;
+            }
+            return NonTerminal4();
+        case 8:
+            // Y -> div F Y
+            on_predict(10);
+            if (!Match(8)) {
+                return false;
+            }
+            if (!NonTerminal3()) {
+                return false;
+            }
+            return NonTerminal4();
+        case 0:
+        case 2:
+        case 4:
+        case 9:
+        case 10:
+            // Y -> EPSILON
+            on_predict(11);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /// @brief T.
+    bool NonTerminal5() {
+        switch (Token()) {
+        case 3:
+        case 5:
+        case 6:
+            // T -> F Y
+            on_predict(12);
+            if (!NonTerminal3()) {
+                return false;
+            }
+            return NonTerminal4();
+        default:
+            return false;
+        }
+    }
+
+    /// @brief X.
+    bool NonTerminal6() {
+        switch (Token()) {
+        case 9:
+            // X -> plus T X
+            on_predict(13);
+            if (!Match(9)) {
+                return false;
+            }
+            if (!NonTerminal5()) {
+                return false;
+            }
+            return NonTerminal6();
+        case 10:
+            // X -> minus T X
+            on_predict(14);
+            if (!Match(10)) {
+                return false;
+            }
+            if (!NonTerminal5()) {
+                return false;
+            }
+            return NonTerminal6();
+        case 0:
+        case 2:
+        case 4:
+            // X -> EPSILON
+            on_predict(15);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /// @brief A.
+    bool NonTerminal7() {
+        switch (Token()) {
+        case 3:
+        case 5:
+        case 6:
+            // A -> T X
+            on_predict(16);
+            if (!NonTerminal5()) {
+                return false;
+            }
+            return NonTerminal6();
+        default:
+            return false;
+        }
+    }
+
+    /// @brief S.
+    bool NonTerminal8() {
+        switch (Token()) {
+        case 3:
+        case 5:
+        case 6:
+            // S -> A $
+            on_predict(17);
+            if (!NonTerminal7()) {
+                return false;
+            }
+            return Match(0);
+        default:
+            return false;
+        }
+    }
+};
+
+/**
+ * @brief Parses a sequence of terminal indices.
+ *
+ * Each non-terminal is a function that switches on the lookahead and calls
+ * the functions of the predicted production, so the native stack takes the
+ * place of the symbol stack and grows with the nesting of the input. The
+ * EOL the axiom ends with is not part of tokens: it is read after the last
+ * token, and the input ends there.
+ *
+ * @param tokens Random-access range of terminal indices.
+ * @param on_predict Called with the id of each production predicted, in
+ * the order of a leftmost derivation.
+ */
+template <typename Tokens, typename OnPredict = IgnorePredictions>
+ParseResult Parse(const Tokens& tokens, OnPredict&& on_predict = {}) {
+    const std::size_t         size = std::size(tokens);
+    Parser<Tokens, OnPredict> parser{tokens, size, 0, on_predict};
+    if (!parser.NonTerminal8() || parser.position != size + 1) {
+        return {false, std::min(parser.position, size)};
+    }
+    return {true, 0};
+}
+
+} // namespace expressions_descent
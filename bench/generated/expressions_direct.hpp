@@ -0,0 +1,761 @@
+// Parser generated by SyntaxTutor. Do not edit.
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace expressions_direct {
+
+inline constexpr std::uint32_t TERMINAL_COUNT     = 11;
+inline constexpr std::uint32_t NON_TERMINAL_COUNT = 10;
+inline constexpr std::uint32_t PRODUCTION_COUNT   = 19;
+
+/// @brief Terminal index of the end of the input.
+inline constexpr std::uint32_t EOL_INDEX = 0;
+
+/// @brief Names of the terminals, by terminal index.
+inline constexpr std::string_view TERMINAL_NAMES[] = {
+    "$",
+    "EPSILON",
+    "comma",
+    "lpar",
+    "rpar",
+    "num",
+    "id",
+    "times",
+    "div",
+    "plus",
+    "minus",
+};
+
+/// @brief Terminal index of a name, or TERMINAL_COUNT if there is none.
+constexpr std::uint32_t FindTerminal(std::string_view terminal) {
+    for (std::uint32_t i = 0; i < TERMINAL_COUNT; ++i) {
+        if (TERMINAL_NAMES[i] == terminal) {
+            return i;
+        }
+    }
+    return TERMINAL_COUNT;
+}
+
+/// @brief Outcome of Parse.
+struct ParseResult {
+    bool        accepted;
+    std::size_t error_position;
+};
+
+inline constexpr std::uint32_t STATE_COUNT = 34;
+
+/// @brief Reduction callback of Parse that does nothing.
+struct IgnoreReductions {
+    constexpr void operator()(std::uint32_t) const {}
+};
+
+/// @brief Terminal index at a position, EOL past the last token.
+template <typename Tokens>
+inline std::uint32_t TokenAt(const Tokens& tokens, std::size_t position,
+                             std::size_t size) {
+    return position < size
+               ? static_cast<std::uint32_t>(std::begin(tokens)[position])
+               : EOL_INDEX;
+}
+
+/**
+ * @brief Parses a sequence of terminal indices.
+ *
+ * Every state is a label that pushes its number and switches on the
+ * lookahead: shifts jump straight to the next state, reductions pop the
+ * stack and jump on the state they uncover. The stack only holds the
+ * states to return to after a reduction.
+ *
+ * The EOL the axiom ends with is not part of tokens: it is read after the
+ * last token, and the input ends there.
+ *
+ * @param tokens Random-access range of terminal indices.
+ * @param stack Vector-like container of std::uint32_t used as the state
+ * stack. It is cleared first, so it can be reused without allocating.
+ * @param on_reduce Called with the id of each production reduced by, and
+ * of the axiom production on acceptance: a rightmost derivation in reverse.
+ */
+template <typename Tokens, typename Stack,
+          typename OnReduce = IgnoreReductions>
+ParseResult Parse(const Tokens& tokens, Stack& stack,
+                  OnReduce&& on_reduce = {}) {
+    const std::size_t size     = std::size(tokens);
+    const std::size_t length   = size + 1;
+    std::size_t       position = 0;
+    stack.clear();
+    goto state_0;
+
+state_0:
+    stack.push_back(0);
+    switch (TokenAt(tokens, position, size)) {
+    case 3:
+        ++position;
+        goto state_1;
+    case 5:
+        ++position;
+        goto state_3;
+    case 6:
+        ++position;
+        goto state_4;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_1:
+    stack.push_back(1);
+    switch (TokenAt(tokens, position, size)) {
+    case 3:
+        ++position;
+        goto state_1;
+    case 5:
+        ++position;
+        goto state_3;
+    case 6:
+        ++position;
+        goto state_4;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_2:
+    stack.push_back(2);
+    switch (TokenAt(tokens, position, size)) {
+    case 7:
+        ++position;
+        goto state_10;
+    case 8:
+        ++position;
+        goto state_11;
+    case 0:
+    case 2:
+    case 4:
+    case 9:
+    case 10:
+        goto reduce_11;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_3:
+    stack.push_back(3);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+    case 7:
+    case 8:
+    case 9:
+    case 10:
+        goto reduce_7;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_4:
+    stack.push_back(4);
+    switch (TokenAt(tokens, position, size)) {
+    case 3:
+        ++position;
+        goto state_13;
+    case 0:
+    case 2:
+    case 4:
+    case 7:
+    case 8:
+    case 9:
+    case 10:
+        goto reduce_5;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_5:
+    stack.push_back(5);
+    switch (TokenAt(tokens, position, size)) {
+    case 9:
+        ++position;
+        goto state_15;
+    case 10:
+        ++position;
+        goto state_16;
+    case 0:
+    case 2:
+    case 4:
+        goto reduce_15;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_6:
+    stack.push_back(6);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+        if (position == length) {
+            return {false, size};
+        }
+        ++position;
+        goto state_17;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_7:
+    stack.push_back(7);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+        if (position != length) {
+            return {false, position};
+        }
+        on_reduce(18);
+        return {true, 0};
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_8:
+    stack.push_back(8);
+    switch (TokenAt(tokens, position, size)) {
+    case 4:
+        ++position;
+        goto state_18;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_9:
+    stack.push_back(9);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+    case 9:
+    case 10:
+        goto reduce_12;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_10:
+    stack.push_back(10);
+    switch (TokenAt(tokens, position, size)) {
+    case 3:
+        ++position;
+        goto state_1;
+    case 5:
+        ++position;
+        goto state_3;
+    case 6:
+        ++position;
+        goto state_4;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_11:
+    stack.push_back(11);
+    switch (TokenAt(tokens, position, size)) {
+    case 3:
+        ++position;
+        goto state_1;
+    case 5:
+        ++position;
+        goto state_3;
+    case 6:
+        ++position;
+        goto state_4;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_12:
+    stack.push_back(12);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+    case 7:
+    case 8:
+    case 9:
+    case 10:
+        goto reduce_8;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_13:
+    stack.push_back(13);
+    switch (TokenAt(tokens, position, size)) {
+    case 3:
+        ++position;
+        goto state_1;
+    case 5:
+        ++position;
+        goto state_3;
+    case 6:
+        ++position;
+        goto state_4;
+    case 4:
+        goto reduce_3;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_14:
+    stack.push_back(14);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+        goto reduce_16;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_15:
+    stack.push_back(15);
+    switch (TokenAt(tokens, position, size)) {
+    case 3:
+        ++position;
+        goto state_1;
+    case 5:
+        ++position;
+        goto state_3;
+    case 6:
+        ++position;
+        goto state_4;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_16:
+    stack.push_back(16);
+    switch (TokenAt(tokens, position, size)) {
+    case 3:
+        ++position;
+        goto state_1;
+    case 5:
+        ++position;
+        goto state_3;
+    case 6:
+        ++position;
+        goto state_4;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_17:
+    stack.push_back(17);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+        goto reduce_17;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_18:
+    stack.push_back(18);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+    case 7:
+    case 8:
+    case 9:
+    case 10:
+        goto reduce_6;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_19:
+    stack.push_back(19);
+    switch (TokenAt(tokens, position, size)) {
+    case 7:
+        ++position;
+        goto state_10;
+    case 8:
+        ++position;
+        goto state_11;
+    case 0:
+    case 2:
+    case 4:
+    case 9:
+    case 10:
+        goto reduce_11;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_20:
+    stack.push_back(20);
+    switch (TokenAt(tokens, position, size)) {
+    case 7:
+        ++position;
+        goto state_10;
+    case 8:
+        ++position;
+        goto state_11;
+    case 0:
+    case 2:
+    case 4:
+    case 9:
+    case 10:
+        goto reduce_11;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_21:
+    stack.push_back(21);
+    switch (TokenAt(tokens, position, size)) {
+    case 4:
+        ++position;
+        goto state_27;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_22:
+    stack.push_back(22);
+    switch (TokenAt(tokens, position, size)) {
+    case 2:
+        ++position;
+        goto state_29;
+    case 4:
+        goto reduce_1;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_23:
+    stack.push_back(23);
+    switch (TokenAt(tokens, position, size)) {
+    case 9:
+        ++position;
+        goto state_15;
+    case 10:
+        ++position;
+        goto state_16;
+    case 0:
+    case 2:
+    case 4:
+        goto reduce_15;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_24:
+    stack.push_back(24);
+    switch (TokenAt(tokens, position, size)) {
+    case 9:
+        ++position;
+        goto state_15;
+    case 10:
+        ++position;
+        goto state_16;
+    case 0:
+    case 2:
+    case 4:
+        goto reduce_15;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_25:
+    stack.push_back(25);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+    case 9:
+    case 10:
+        goto reduce_9;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_26:
+    stack.push_back(26);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+    case 9:
+    case 10:
+        goto reduce_10;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_27:
+    stack.push_back(27);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+    case 7:
+    case 8:
+    case 9:
+    case 10:
+        goto reduce_4;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_28:
+    stack.push_back(28);
+    switch (TokenAt(tokens, position, size)) {
+    case 4:
+        goto reduce_2;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_29:
+    stack.push_back(29);
+    switch (TokenAt(tokens, position, size)) {
+    case 3:
+        ++position;
+        goto state_1;
+    case 5:
+        ++position;
+        goto state_3;
+    case 6:
+        ++position;
+        goto state_4;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_30:
+    stack.push_back(30);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+        goto reduce_13;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_31:
+    stack.push_back(31);
+    switch (TokenAt(tokens, position, size)) {
+    case 0:
+    case 2:
+    case 4:
+        goto reduce_14;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_32:
+    stack.push_back(32);
+    switch (TokenAt(tokens, position, size)) {
+    case 2:
+        ++position;
+        goto state_29;
+    case 4:
+        goto reduce_1;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+state_33:
+    stack.push_back(33);
+    switch (TokenAt(tokens, position, size)) {
+    case 4:
+        goto reduce_0;
+    default:
+        return {false, std::min(position, size)};
+    }
+
+reduce_0: // M -> comma A M
+    stack.resize(stack.size() - 3);
+    on_reduce(0);
+    switch (stack.back()) {
+    case 32:
+        goto state_33;
+    default:
+        goto state_28;
+    }
+
+reduce_1: // M -> EPSILON
+    on_reduce(1);
+    switch (stack.back()) {
+    case 32:
+        goto state_33;
+    default:
+        goto state_28;
+    }
+
+reduce_2: // L -> A M
+    stack.resize(stack.size() - 2);
+    on_reduce(2);
+    goto state_21;
+
+reduce_3: // L -> EPSILON
+    on_reduce(3);
+    goto state_21;
+
+reduce_4: // Z -> lpar L rpar
+    stack.resize(stack.size() - 3);
+    on_reduce(4);
+    goto state_12;
+
+reduce_5: // Z -> EPSILON
+    on_reduce(5);
+    goto state_12;
+
+reduce_6: // F -> lpar A rpar
+    stack.resize(stack.size() - 3);
+    on_reduce(6);
+    switch (stack.back()) {
+    case 10:
+        goto state_19;
+    case 11:
+        goto state_20;
+    default:
+        goto state_2;
+    }
+
+reduce_7: // F -> num
+    stack.resize(stack.size() - 1);
+    on_reduce(7);
+    switch (stack.back()) {
+    case 10:
+        goto state_19;
+    case 11:
+        goto state_20;
+    default:
+        goto state_2;
+    }
+
+reduce_8: // F -> id Z
+    stack.resize(stack.size() - 2);
+    on_reduce(8);
+    switch (stack.back()) {
+    case 10:
+        goto state_19;
+    case 11:
+        goto state_20;
+    default:
+        goto state_2;
+    }
+
+reduce_9: // Y -> times F Y
+    stack.resize(stack.size() - 3);
+    on_reduce(9);
+    switch (stack.back()) {
+    case 19:
+        goto state_25;
+    case 20:
+        goto state_26;
+    default:
+        goto state_9;
+    }
+
+reduce_10: // Y -> div F Y
+    stack.resize(stack.size() - 3);
+    on_reduce(10);
+    switch (stack.back()) {
+    case 19:
+        goto state_25;
+    case 20:
+        goto state_26;
+    default:
+        goto state_9;
+    }
+
+reduce_11: // Y -> EPSILON
+    on_reduce(11);
+    switch (stack.back()) {
+    case 19:
+        goto state_25;
+    case 20:
+        goto state_26;
+    default:
+        goto state_9;
+    }
+
+reduce_12: // T -> F Y
+    stack.resize(stack.size() - 2);
+    on_reduce(12);
+    switch (stack.back()) {
+    case 15:
+        goto state_23;
+    case 16:
+        goto state_24;
+    default:
+        goto state_5;
+    }
+
+reduce_13: // X -> plus T X
+    stack.resize(stack.size() - 3);
+    on_reduce(13);
+    switch (stack.back()) {
+    case 23:
+        goto state_30;
+    case 24:
+        goto state_31;
+    default:
+        goto state_14;
+    }
+
+reduce_14: // X -> minus T X
+    stack.resize(stack.size() - 3);
+    on_reduce(14);
+    switch (stack.back()) {
+    case 23:
+        goto state_30;
+    case 24:
+        goto state_31;
+    default:
+        goto state_14;
+    }
+
+reduce_15: // X -> EPSILON
+    on_reduce(15);
+    switch (stack.back()) {
+    case 23:
+        goto state_30;
+    case 24:
+        goto state_31;
+    default:
+        goto state_14;
+    }
+
+reduce_16: // A -> T X
+    stack.resize(stack.size() - 2);
+    on_reduce(16);
+    switch (stack.back()) {
+    case 1:
+        goto state_8;
+    case 13:
+        goto state_22;
+    case 29:
+        goto state_32;
+    default:
+        goto state_6;
+    }
+
+reduce_17: // S -> A $
+    stack.resize(stack.size() - 2);
+    on_reduce(17);
+    goto state_7;
+
+}
+
+/// @brief Parses with a state stack of its own, see above.
+template <typename Tokens>
+inline ParseResult Parse(const Tokens& tokens) {
+    std::vector<std::uint32_t> stack;
+    return Parse(tokens, stack);
+}
+
+} // namespace expressions_direct
@@ -0,0 +1,278 @@
+// Parser generated by SyntaxTutor. Do not edit.
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace expressions_tables {
+
+inline constexpr std::uint32_t TERMINAL_COUNT     = 11;
+inline constexpr std::uint32_t NON_TERMINAL_COUNT = 10;
+inline constexpr std::uint32_t PRODUCTION_COUNT   = 19;
+
+/// @brief Terminal index of the end of the input.
+inline constexpr std::uint32_t EOL_INDEX = 0;
+
+/// @brief Names of the terminals, by terminal index.
+inline constexpr std::string_view TERMINAL_NAMES[] = {
+    "$",
+    "EPSILON",
+    "comma",
+    "lpar",
+    "rpar",
+    "num",
+    "id",
+    "times",
+    "div",
+    "plus",
+    "minus",
+};
+
+/// @brief Terminal index of a name, or TERMINAL_COUNT if there is none.
+constexpr std::uint32_t FindTerminal(std::string_view terminal) {
+    for (std::uint32_t i = 0; i < TERMINAL_COUNT; ++i) {
+        if (TERMINAL_NAMES[i] == terminal) {
+            return i;
+        }
+    }
+    return TERMINAL_COUNT;
+}
+
+/// @brief Outcome of Parse.
+struct ParseResult {
+    bool        accepted;
+    std::size_t error_position;
+};
+
+inline constexpr std::uint32_t STATE_COUNT = 34;
+
+/// @brief Reduction callback of Parse that does nothing.
+struct IgnoreReductions {
+    constexpr void operator()(std::uint32_t) const {}
+};
+
+/// @brief Entry of GOTO where there is no transition.
+inline constexpr std::uint32_t NO_STATE = 0xffffffff;
+
+/// @brief Productions, by id:
+/// - 0: M -> comma A M
+/// - 1: M -> EPSILON
+/// - 2: L -> A M
+/// - 3: L -> EPSILON
+/// - 4: Z -> lpar L rpar
+/// - 5: Z -> EPSILON
+/// - 6: F -> lpar A rpar
+/// - 7: F -> num
+/// - 8: F -> id Z
+/// - 9: Y -> times F Y
+/// - 10: Y -> div F Y
+/// - 11: Y -> EPSILON
+/// - 12: T -> F Y
+/// - 13: X -> plus T X
+/// - 14: X -> minus T X
+/// - 15: X -> EPSILON
+/// - 16: A -> T X
+/// - 17: S -> A $
+/// - 18: S' -> S
+inline constexpr std::uint32_t RHS_LENGTH[] = {
+    3, 0, 2, 0, 3, 0, 3, 1, 2, 3, 3, 0, 2, 3, 3, 0, 2, 2, 1,
+};
+
+/// @brief Non-terminal index of the left-hand side of each production.
+inline constexpr std::uint32_t LHS[] = {
+    0, 0, 1, 1, 2, 2, 3, 3, 3, 4, 4, 4, 5, 6, 6, 6, 7, 8, 9,
+};
+
+/// @brief ACTION table, one row per state and one column per terminal index:
+/// the kind in the top two bits (1 shift, 2 reduce, 3 accept, 0 error) and
+/// the target state, or production reduced or accepted on, in the rest.
+inline constexpr std::uint32_t ACTION[] = {
+    0x0, 0x0, 0x0, 0x40000001, 0x0, 0x40000003, 0x40000004, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x40000001, 0x0, 0x40000003, 0x40000004, 0x0, 0x0, 0x0, 0x0,
+    0x8000000b, 0x0, 0x8000000b, 0x0, 0x8000000b, 0x0, 0x0, 0x4000000a,
+    0x4000000b, 0x8000000b, 0x8000000b,
+    0x80000007, 0x0, 0x80000007, 0x0, 0x80000007, 0x0, 0x0, 0x80000007,
+    0x80000007, 0x80000007, 0x80000007,
+    0x80000005, 0x0, 0x80000005, 0x4000000d, 0x80000005, 0x0, 0x0, 0x80000005,
+    0x80000005, 0x80000005, 0x80000005,
+    0x8000000f, 0x0, 0x8000000f, 0x0, 0x8000000f, 0x0, 0x0, 0x0, 0x0,
+    0x4000000f, 0x40000010,
+    0x40000011, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0xc0000012, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x40000012, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x8000000c, 0x0, 0x8000000c, 0x0, 0x8000000c, 0x0, 0x0, 0x0, 0x0,
+    0x8000000c, 0x8000000c,
+    0x0, 0x0, 0x0, 0x40000001, 0x0, 0x40000003, 0x40000004, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x40000001, 0x0, 0x40000003, 0x40000004, 0x0, 0x0, 0x0, 0x0,
+    0x80000008, 0x0, 0x80000008, 0x0, 0x80000008, 0x0, 0x0, 0x80000008,
+    0x80000008, 0x80000008, 0x80000008,
+    0x0, 0x0, 0x0, 0x40000001, 0x80000003, 0x40000003, 0x40000004, 0x0, 0x0,
+    0x0, 0x0,
+    0x80000010, 0x0, 0x80000010, 0x0, 0x80000010, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x40000001, 0x0, 0x40000003, 0x40000004, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x40000001, 0x0, 0x40000003, 0x40000004, 0x0, 0x0, 0x0, 0x0,
+    0x80000011, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x80000006, 0x0, 0x80000006, 0x0, 0x80000006, 0x0, 0x0, 0x80000006,
+    0x80000006, 0x80000006, 0x80000006,
+    0x8000000b, 0x0, 0x8000000b, 0x0, 0x8000000b, 0x0, 0x0, 0x4000000a,
+    0x4000000b, 0x8000000b, 0x8000000b,
+    0x8000000b, 0x0, 0x8000000b, 0x0, 0x8000000b, 0x0, 0x0, 0x4000000a,
+    0x4000000b, 0x8000000b, 0x8000000b,
+    0x0, 0x0, 0x0, 0x0, 0x4000001b, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x4000001d, 0x0, 0x80000001, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x8000000f, 0x0, 0x8000000f, 0x0, 0x8000000f, 0x0, 0x0, 0x0, 0x0,
+    0x4000000f, 0x40000010,
+    0x8000000f, 0x0, 0x8000000f, 0x0, 0x8000000f, 0x0, 0x0, 0x0, 0x0,
+    0x4000000f, 0x40000010,
+    0x80000009, 0x0, 0x80000009, 0x0, 0x80000009, 0x0, 0x0, 0x0, 0x0,
+    0x80000009, 0x80000009,
+    0x8000000a, 0x0, 0x8000000a, 0x0, 0x8000000a, 0x0, 0x0, 0x0, 0x0,
+    0x8000000a, 0x8000000a,
+    0x80000004, 0x0, 0x80000004, 0x0, 0x80000004, 0x0, 0x0, 0x80000004,
+    0x80000004, 0x80000004, 0x80000004,
+    0x0, 0x0, 0x0, 0x0, 0x80000002, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x40000001, 0x0, 0x40000003, 0x40000004, 0x0, 0x0, 0x0, 0x0,
+    0x8000000d, 0x0, 0x8000000d, 0x0, 0x8000000d, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x8000000e, 0x0, 0x8000000e, 0x0, 0x8000000e, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x4000001d, 0x0, 0x80000001, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x80000000, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+};
+
+/// @brief GOTO table, one row per state and one column per non-terminal index.
+inline constexpr std::uint32_t GOTO[] = {
+    NO_STATE, NO_STATE, NO_STATE, 2, NO_STATE, 5, NO_STATE, 6, 7, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, 2, NO_STATE, 5, NO_STATE, 8, NO_STATE,
+    NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, 9, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, 12, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, 14, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, 19, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, 20, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, 21, NO_STATE, 2, NO_STATE, 5, NO_STATE, 22, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, 2, NO_STATE, 23, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, 2, NO_STATE, 24, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, 25, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, 26, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    28, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, 30, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, 31, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, 2, NO_STATE, 5, NO_STATE, 32, NO_STATE,
+    NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+    33, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE, NO_STATE,
+    NO_STATE, NO_STATE, NO_STATE,
+};
+
+/**
+ * @brief Parses a sequence of terminal indices.
+ *
+ * The EOL the axiom ends with is not part of tokens: it is read after the
+ * last token, and the input ends there.
+ *
+ * @param tokens Random-access range of terminal indices.
+ * @param stack Vector-like container of std::uint32_t used as the state
+ * stack. It is cleared first, so it can be reused without allocating.
+ * @param on_reduce Called with the id of each production reduced by, and
+ * of the axiom production on acceptance: a rightmost derivation in reverse.
+ */
+template <typename Tokens, typename Stack,
+          typename OnReduce = IgnoreReductions>
+constexpr ParseResult Parse(const Tokens& tokens, Stack& stack,
+                            OnReduce&& on_reduce = {}) {
+    const std::size_t size     = std::size(tokens);
+    const std::size_t length   = size + 1;
+    std::size_t       position = 0;
+    stack.clear();
+    stack.push_back(0);
+    while (true) {
+        std::uint32_t token = position < size
+                                  ? static_cast<std::uint32_t>(
+                                        std::begin(tokens)[position])
+                                  : EOL_INDEX;
+        if (token >= TERMINAL_COUNT) {
+            return {false, position};
+        }
+        std::uint32_t action = ACTION[stack.back() * TERMINAL_COUNT + token];
+        std::uint32_t target = action & ((std::uint32_t{1} << 30) - 1);
+        switch (action >> 30) {
+        case 1:
+            if (position == length) {
+                return {false, size};
+            }
+            stack.push_back(target);
+            ++position;
+            break;
+        case 2:
+            stack.resize(stack.size() - RHS_LENGTH[target]);
+            stack.push_back(
+                GOTO[stack.back() * NON_TERMINAL_COUNT + LHS[target]]);
+            on_reduce(target);
+            break;
+        case 3:
+            if (position != length) {
+                return {false, position};
+            }
+            on_reduce(target);
+            return {true, 0};
+        default:
+            return {false, std::min(position, size)};
+        }
+    }
+}
+
+/// @brief Parses with a state stack of its own, see above.
+template <typename Tokens>
+constexpr ParseResult Parse(const Tokens& tokens) {
+    std::vector<std::uint32_t> stack;
+    return Parse(tokens, stack);
+}
+
+} // namespace expressions_tables
@@ -0,0 +1,72 @@
+// Benchmark of ParseBatch: the same sentences parsed with 1 to N threads,
+// N being the first argument or the hardware concurrency.
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "batch_parse.hpp"
+#include "bench.hpp"
+#include "grammar.hpp"
+#include "lalr1_parser.hpp"
+#include "symbol_table.hpp"
+
+namespace {
+
+/// @brief Sentences parsed by every measurement.
+constexpr std::size_t SENTENCES = 20000;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned int max_threads =
+        argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1]))
+                 : std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+
+    Grammar gr(STATEMENTS);
+    Grammar augmented = gr;
+    augmented.TransformToAugmentedGrammar();
+    LALR1Parser parser(augmented);
+    parser.MakeParser();
+
+    const std::vector<std::vector<SymbolId>> sentences =
+        Sentences(gr, SENTENCES);
+    const std::size_t tokens = TokenCount(sentences);
+    std::cout << "ParseBatch, statements (LALR(1)): " << sentences.size()
+              << " sentences, " << tokens << " tokens, "
+              << std::thread::hardware_concurrency() << " hardware threads\n";
+    std::cout << std::setw(9) << "threads" << std::setw(12) << "per batch"
+              << std::setw(18) << "throughput" << std::setw(10) << "speedup"
+              << '\n';
+
+    double single = 0;
+    for (unsigned int threads = 1; threads <= max_threads; ++threads) {
+        std::size_t rejected = 0;
+        double      seconds  = TimePerCall([&] {
+            for (const BatchResult& result :
+                 ParseBatch(parser,
+                            std::span<const std::vector<SymbolId>>(sentences),
+                            threads)) {
+                rejected += !result.accepted;
+            }
+        });
+        if (rejected != 0) {
+            std::cout << "a sentence was rejected\n";
+            return 1;
+        }
+        if (threads == 1) {
+            single = seconds;
+        }
+        std::cout << std::fixed << std::setw(9) << threads << std::setw(9)
+                  << std::setprecision(2) << seconds * 1e3 << " ms"
+                  << std::setw(7) << std::setprecision(1)
+                  << tokens / seconds / 1e6 << " Mtokens/s" << std::setw(9)
+                  << std::setprecision(2) << single / seconds << "x\n";
+    }
+    return 0;
+}
@@ -0,0 +1,8 @@
+TEMPLATE = app
+TARGET   = parse_batch
+CONFIG  += thread
+
+include(backend.pri)
+
+SOURCES += \
+    parse_batch.cpp
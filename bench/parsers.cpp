@@ -0,0 +1,354 @@
+// Benchmarks of the parsers of the backend. Every section prints one row per
+// variant; times are means over repeated runs (see TimePerCall).
+//
+// The parsers in generated/ are written by `parsers --emit generated` from
+// the current emitters; the benchmark checks they still agree with the
+// runtime parsers before timing them.
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+#include "generated/expressions_descent.hpp"
+#include "generated/expressions_direct.hpp"
+#include "generated/expressions_tables.hpp"
+#include "grammar.hpp"
+#include "lalr1_parser.hpp"
+#include "ll1_parser.hpp"
+#include "lr1_parser.hpp"
+#include "parser_emitter.hpp"
+#include "parser_image.hpp"
+#include "slr1_parser.hpp"
+#include "symbol_table.hpp"
+
+// The generated tables need no setup: they can even parse at compile time
+static_assert(expressions_tables::Parse(
+                  std::array{expressions_tables::FindTerminal("num")})
+                  .accepted);
+
+namespace {
+
+/// @brief Outcome of one table construction.
+struct BuildResult {
+    bool        built;
+    std::size_t states;
+};
+
+/// @brief Builds the tables of parser P, made from the augmented grammar of
+/// rules and args.
+template <typename P, typename... Args>
+BuildResult Build(const Rules& rules, Args... args) {
+    Grammar gr(rules);
+    gr.TransformToAugmentedGrammar();
+    P    parser(std::move(gr), args...);
+    bool built = parser.MakeParser();
+    return {built, parser.states_.size()};
+}
+
+void PrintRow(const std::string& name, const std::string& states,
+              const std::string& built, double seconds) {
+    std::cout << "  " << std::left << std::setw(18) << name << std::right
+              << std::setw(8) << states << std::setw(8) << built
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << seconds * 1e6 << " us\n";
+}
+
+template <typename P, typename... Args>
+void BenchBuild(const std::string& name, const Rules& rules, Args... args) {
+    BuildResult result = Build<P>(rules, args...);
+    double seconds = TimePerCall([&] { Build<P>(rules, args...); });
+    PrintRow(name, std::to_string(result.states),
+             result.built ? "yes" : "no", seconds);
+}
+
+/**
+ * @brief Time to build each kind of LR table from the rules, grammar and
+ * analysis included. The first row is the grammar alone, which every other
+ * row includes.
+ */
+void BenchLrConstruction(const std::string& name, const Rules& rules) {
+    std::cout << "LR table construction, " << name << "\n";
+    std::cout << "  " << std::left << std::setw(18) << "tables" << std::right
+              << std::setw(8) << "states" << std::setw(8) << "built"
+              << std::setw(15) << "per build\n";
+    double grammar = TimePerCall([&] {
+        Grammar gr(rules);
+        gr.TransformToAugmentedGrammar();
+        gr.Analysis();
+    });
+    PrintRow("grammar only", "", "", grammar);
+    BenchBuild<SLR1Parser>("SLR(1)", rules);
+    BenchBuild<LALR1Parser>("LALR(1)", rules);
+    BenchBuild<LR1Parser>("LR(1) Pager", rules, LR1Parser::Mode::Pager);
+    BenchBuild<LR1Parser>("LR(1) canonical", rules,
+                          LR1Parser::Mode::Canonical);
+    std::cout << '\n';
+}
+
+/// @brief Sentences the parsing benchmarks parse.
+constexpr std::size_t SENTENCES = 2000;
+
+/**
+ * @brief Prints the throughput of a parser over the sentences.
+ *
+ * @param sentences SymbolIds for the runtime parsers, terminal indices for
+ * the generated ones.
+ * @param parse Parses one sentence, returning whether it was accepted.
+ */
+template <typename Token, typename F>
+void BenchThroughput(const std::string&                     name,
+                     const std::vector<std::vector<Token>>& sentences,
+                     F&&                                    parse) {
+    std::size_t accepted = 0;
+    double      seconds  = TimePerCall([&] {
+        for (const std::vector<Token>& sentence : sentences) {
+            accepted += parse(sentence);
+        }
+    });
+    // Every call parses every sentence, all of them valid
+    if (accepted % sentences.size() != 0) {
+        std::cout << "  " << name << ": a sentence was rejected\n";
+    }
+    std::cout << "  " << std::left << std::setw(26) << name << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1)
+              << TokenCount(sentences) / seconds / 1e6 << " Mtokens/s\n";
+}
+
+/// @brief A grammar with S' → S added.
+Grammar Augmented(Grammar gr) {
+    gr.TransformToAugmentedGrammar();
+    return gr;
+}
+
+/// @brief The runtime parsers of EXPRESSIONS, which is LL(1) and SLR(1).
+struct ExpressionParsers {
+    ExpressionParsers() : gr(EXPRESSIONS), ll1(gr), slr1(Augmented(gr)) {
+        ll1.CreateLL1Table();
+        slr1.MakeParser();
+    }
+
+    Grammar    gr;
+    LL1Parser  ll1;
+    SLR1Parser slr1;
+};
+
+/// @brief Writes the headers of the generated parsers into directory.
+int Emit(const std::filesystem::path& directory) {
+    ExpressionParsers parsers;
+    std::filesystem::create_directories(directory);
+    std::ofstream(directory / "expressions_tables.hpp")
+        << EmitConstexprParser(parsers.slr1, "expressions_tables");
+    std::ofstream(directory / "expressions_direct.hpp")
+        << EmitDirectCodedParser(parsers.slr1, "expressions_direct");
+    std::ofstream(directory / "expressions_descent.hpp")
+        << EmitRecursiveDescentParser(parsers.ll1, "expressions_descent");
+    return 0;
+}
+
+/// @brief The sentences as terminal indices of a generated parser, mapped
+/// by name with its FindTerminal.
+template <typename Find>
+std::vector<std::vector<std::uint32_t>>
+TerminalIndices(const std::vector<std::vector<SymbolId>>& sentences,
+                const SymbolTable& st, Find&& find) {
+    std::vector<std::vector<std::uint32_t>> indices;
+    indices.reserve(sentences.size());
+    for (const std::vector<SymbolId>& sentence : sentences) {
+        std::vector<std::uint32_t>& tokens = indices.emplace_back();
+        for (SymbolId token : sentence) {
+            tokens.push_back(find(st.Name(token)));
+        }
+    }
+    return indices;
+}
+
+/**
+ * @brief Checks that a generated parser gives the results of a runtime one,
+ * on the sentences and on each of them with its middle token removed.
+ *
+ * @param runtime Parses SymbolIds, returning the acceptance and the error
+ * position.
+ * @param generated Parses terminal indices, likewise.
+ */
+template <typename Runtime, typename Generated>
+bool Agree(const std::string&                             name,
+           const std::vector<std::vector<SymbolId>>&      sentences,
+           const std::vector<std::vector<std::uint32_t>>& indices,
+           Runtime&& runtime, Generated&& generated) {
+    for (std::size_t i = 0; i < sentences.size(); ++i) {
+        std::vector<SymbolId>      tokens = sentences[i];
+        std::vector<std::uint32_t> mapped = indices[i];
+        bool agree = runtime(tokens) == generated(mapped);
+        if (!tokens.empty()) {
+            tokens.erase(tokens.begin() + tokens.size() / 2);
+            mapped.erase(mapped.begin() + mapped.size() / 2);
+        }
+        if (!agree || runtime(tokens) != generated(mapped)) {
+            std::cout << "  " << name << " disagrees with the runtime parser;"
+                      << " run parsers --emit generated\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Time from nothing to the first parse result: building the runtime
+ * tables, or none at all for the generated ones.
+ */
+void BenchStartup() {
+    ExpressionParsers parsers;
+    const std::vector<SymbolId> sentence = Sentences(parsers.gr, 1)[0];
+    const std::vector<std::uint32_t> indices = TerminalIndices(
+        {sentence}, parsers.gr.st_, expressions_tables::FindTerminal)[0];
+
+    std::cout << "Startup to the first parse, expressions\n";
+    double runtime = TimePerCall([&] {
+        SLR1Parser slr1(Augmented(Grammar(EXPRESSIONS)));
+        slr1.MakeParser();
+        slr1.Parse(sentence);
+    });
+    double tables = TimePerCall([&] { expressions_tables::Parse(indices); });
+    std::cout << "  " << std::left << std::setw(26) << "SLR1Parser, built"
+              << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << runtime * 1e6 << " us\n"
+              << "  " << std::left << std::setw(26) << "constexpr tables"
+              << std::right << std::setw(10) << tables * 1e6 << " us\n\n";
+}
+
+/**
+ * @brief Time to get the LL(1) and SLR(1) tables of a grammar from its
+ * rules: building the parsers, building their image, or mapping the image
+ * stored by an earlier run from a ParserCache.
+ */
+void BenchParserCache(const std::string& name, const Rules& rules) {
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "syntax_tutor_bench";
+    std::filesystem::remove_all(directory);
+    ParserCache cache(directory);
+    cache.Load(Grammar(rules));
+
+    std::cout << "Parser tables from the rules, " << name << "\n";
+    double built = TimePerCall([&] {
+        Grammar    gr(rules);
+        LL1Parser  ll1(gr);
+        SLR1Parser slr1(Augmented(gr));
+        ll1.CreateLL1Table();
+        slr1.MakeParser();
+    });
+    double image  = TimePerCall([&] { ParserImage::Build(Grammar(rules)); });
+    double mapped = TimePerCall([&] { cache.Load(Grammar(rules)); });
+    std::filesystem::remove_all(directory);
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto& [row, seconds] :
+         {std::pair("LL1Parser and SLR1Parser", built),
+          std::pair("ParserImage::Build", image),
+          std::pair("ParserCache::Load, mapped", mapped)}) {
+        std::cout << "  " << std::left << std::setw(26) << row << std::right
+                  << std::setw(10) << seconds * 1e6 << " us\n";
+    }
+    std::cout << '\n';
+}
+
+/**
+ * @brief Throughput of the parsers of EXPRESSIONS over the same random
+ * sentences.
+ */
+bool BenchParsing() {
+    ExpressionParsers parsers;
+    const LL1Parser&  ll1  = parsers.ll1;
+    const SLR1Parser& slr1 = parsers.slr1;
+
+    const std::vector<std::vector<SymbolId>> sentences =
+        Sentences(parsers.gr, SENTENCES);
+    const std::vector<std::vector<std::uint32_t>> indices = TerminalIndices(
+        sentences, parsers.gr.st_, expressions_tables::FindTerminal);
+    const std::vector<std::vector<std::uint32_t>> descent_indices =
+        TerminalIndices(sentences, parsers.gr.st_,
+                        expressions_descent::FindTerminal);
+    std::cout << "Parsing, expressions: " << sentences.size()
+              << " sentences, " << TokenCount(sentences) << " tokens\n";
+
+    SLR1Parser::ParseStacks slr1_stacks = slr1.MakeParseStacks();
+    auto slr1_result = [&](std::span<const SymbolId> tokens) {
+        SLR1Parser::ParseResult result = slr1.Parse(tokens, slr1_stacks);
+        return std::pair(result.accepted, result.error_position);
+    };
+    auto tables_result = [](const std::vector<std::uint32_t>& tokens) {
+        expressions_tables::ParseResult result =
+            expressions_tables::Parse(tokens);
+        return std::pair(result.accepted, result.error_position);
+    };
+    auto direct_result = [](const std::vector<std::uint32_t>& tokens) {
+        expressions_direct::ParseResult result =
+            expressions_direct::Parse(tokens);
+        return std::pair(result.accepted, result.error_position);
+    };
+    LL1Parser::ParseStacks ll1_stacks = ll1.MakeParseStacks();
+    auto ll1_result = [&](std::span<const SymbolId> tokens) {
+        LL1Parser::ParseResult result = ll1.Parse(tokens, ll1_stacks);
+        return std::pair(result.accepted, result.error_position);
+    };
+    auto descent_result = [](const std::vector<std::uint32_t>& tokens) {
+        expressions_descent::ParseResult result =
+            expressions_descent::Parse(tokens);
+        return std::pair(result.accepted, result.error_position);
+    };
+    // Both generated LR parsers number terminals as SLR1Parser does
+    if (!Agree("constexpr tables", sentences, indices, slr1_result,
+               tables_result) ||
+        !Agree("direct-coded parser", sentences, indices, slr1_result,
+               direct_result) ||
+        !Agree("recursive-descent parser", sentences, descent_indices,
+               ll1_result, descent_result)) {
+        return false;
+    }
+
+    BenchThroughput("LL(1) Parse", sentences,
+                    [&](std::span<const SymbolId> tokens) {
+                        return ll1.Parse(tokens, ll1_stacks).accepted;
+                    });
+    BenchThroughput("LL(1) recursive descent", descent_indices,
+                    [](const std::vector<std::uint32_t>& tokens) {
+                        return expressions_descent::Parse(tokens).accepted;
+                    });
+    BenchThroughput("SLR(1) Parse", sentences,
+                    [&](std::span<const SymbolId> tokens) {
+                        return slr1.Parse(tokens, slr1_stacks).accepted;
+                    });
+    std::vector<std::uint32_t> stack;
+    BenchThroughput("SLR(1) constexpr tables", indices,
+                    [&](const std::vector<std::uint32_t>& tokens) {
+                        return expressions_tables::Parse(tokens, stack)
+                            .accepted;
+                    });
+    BenchThroughput("SLR(1) direct-coded", indices,
+                    [&](const std::vector<std::uint32_t>& tokens) {
+                        return expressions_direct::Parse(tokens, stack)
+                            .accepted;
+                    });
+    std::cout << '\n';
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::string(argv[1]) == "--emit") {
+        return Emit(argv[2]);
+    }
+    BenchLrConstruction("expressions", EXPRESSIONS);
+    BenchLrConstruction("statements", STATEMENTS);
+    BenchStartup();
+    BenchParserCache("expressions", EXPRESSIONS);
+    BenchParserCache("statements", STATEMENTS);
+    return BenchParsing() ? 0 : 1;
+}
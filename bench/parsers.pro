@@ -0,0 +1,12 @@
+TEMPLATE = app
+TARGET   = parsers
+
+include(backend.pri)
+
+SOURCES += \
+    parsers.cpp
+
+HEADERS += \
+    generated/expressions_descent.hpp \
+    generated/expressions_direct.hpp \
+    generated/expressions_tables.hpp
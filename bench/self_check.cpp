@@ -0,0 +1,380 @@
+// Self-checks of the backend. Each section compares a structure derived from
+// a parser with the parser itself, over grammars of every GrammarFactory
+// level and a large grammar, and prints one row per set of grammars. The
+// program fails if any row has a mismatch.
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.hpp"
+#include "compressed_table.hpp"
+#include "grammar.hpp"
+#include "grammar_analysis.hpp"
+#include "grammar_factory.hpp"
+#include "ll1_parser.hpp"
+#include "parser_image.hpp"
+#include "slr1_parser.hpp"
+#include "static_grammar.hpp"
+#include "symbol_table.hpp"
+
+namespace {
+
+/// @brief Highest level GrammarFactory generates.
+constexpr int FACTORY_LEVELS = 7;
+
+/// @brief Grammars drawn from each GrammarFactory level.
+constexpr int SAMPLES = 10;
+
+/// @brief Precedence levels of LargeGrammar.
+constexpr int PRECEDENCE_LEVELS = 60;
+
+/// @brief Random sentences parsed with each grammar.
+constexpr std::size_t SENTENCES = 100;
+
+// The grammars of GrammarFactory::Init, in its order
+constexpr StaticGrammar INIT_1{{{"A", "a b A"}, {"A", "a"}}};
+constexpr StaticGrammar INIT_2{{{"A", "a b A"}, {"A", "a b"}}};
+constexpr StaticGrammar INIT_3{{{"A", "a A b"}, {"A", "EPSILON"}}};
+constexpr StaticGrammar INIT_4{{{"A", "A a"}, {"A", "EPSILON"}}};
+constexpr StaticGrammar INIT_5{{{"A", "a A"}, {"A", "EPSILON"}}};
+constexpr StaticGrammar INIT_6{{{"A", "a A c"}, {"A", "b"}}};
+constexpr StaticGrammar INIT_7{{{"A", "a A a"}, {"A", "b"}}};
+constexpr StaticGrammar INIT_8{{{"A", "A a"}, {"A", "b"}}};
+constexpr StaticGrammar INIT_9{{{"A", "b A"}, {"A", "a"}}};
+
+// All of them are SLR(1): the tables would not compile otherwise
+constexpr auto INIT_1_SLR1 = MakeStaticSLR1Table<INIT_1>();
+constexpr auto INIT_2_SLR1 = MakeStaticSLR1Table<INIT_2>();
+constexpr auto INIT_3_SLR1 = MakeStaticSLR1Table<INIT_3>();
+constexpr auto INIT_4_SLR1 = MakeStaticSLR1Table<INIT_4>();
+constexpr auto INIT_5_SLR1 = MakeStaticSLR1Table<INIT_5>();
+constexpr auto INIT_6_SLR1 = MakeStaticSLR1Table<INIT_6>();
+constexpr auto INIT_7_SLR1 = MakeStaticSLR1Table<INIT_7>();
+constexpr auto INIT_8_SLR1 = MakeStaticSLR1Table<INIT_8>();
+constexpr auto INIT_9_SLR1 = MakeStaticSLR1Table<INIT_9>();
+
+// Those without left recursion or a common prefix are LL(1) too
+constexpr auto INIT_3_LL1 = MakeStaticLL1Table<INIT_3>();
+constexpr auto INIT_5_LL1 = MakeStaticLL1Table<INIT_5>();
+constexpr auto INIT_6_LL1 = MakeStaticLL1Table<INIT_6>();
+constexpr auto INIT_7_LL1 = MakeStaticLL1Table<INIT_7>();
+constexpr auto INIT_9_LL1 = MakeStaticLL1Table<INIT_9>();
+static_assert(StaticLL1Table(INIT_1).conflicts_ != 0);
+static_assert(StaticLL1Table(INIT_2).conflicts_ != 0);
+static_assert(StaticLL1Table(INIT_4).conflicts_ != 0);
+static_assert(StaticLL1Table(INIT_8).conflicts_ != 0);
+
+/// @brief Terminal indices of the named terminals of a StaticGrammar.
+template <typename StaticGr, std::size_t N>
+constexpr std::array<std::uint32_t, N> Tokens(const StaticGr& gr,
+                                              const char* const (&names)[N]) {
+    std::array<std::uint32_t, N> tokens{};
+    for (std::size_t i = 0; i < N; ++i) {
+        tokens[i] = gr.FindTerminal(names[i]);
+    }
+    return tokens;
+}
+
+static_assert(INIT_1_SLR1.Parse(Tokens(INIT_1, {"a", "b", "a"})).accepted);
+static_assert(!INIT_1_SLR1.Parse(Tokens(INIT_1, {"a", "b"})).accepted);
+static_assert(INIT_2_SLR1.Parse(Tokens(INIT_2, {"a", "b", "a", "b"})).accepted);
+static_assert(INIT_2_SLR1.Parse(Tokens(INIT_2, {"a", "a"})).error_position ==
+              1);
+static_assert(INIT_3_SLR1.Parse(std::array<std::uint32_t, 0>{}).accepted);
+static_assert(INIT_3_LL1.Parse(Tokens(INIT_3, {"a", "a", "b", "b"})).accepted);
+static_assert(!INIT_3_LL1.Parse(Tokens(INIT_3, {"a", "b", "b"})).accepted);
+static_assert(INIT_4_SLR1.Parse(Tokens(INIT_4, {"a", "a"})).accepted);
+static_assert(INIT_5_LL1.Parse(Tokens(INIT_5, {"a", "a", "a"})).accepted);
+static_assert(INIT_6_LL1.Parse(Tokens(INIT_6, {"a", "b", "c"})).accepted);
+static_assert(INIT_6_SLR1.Parse(Tokens(INIT_6, {"a", "b"})).error_position ==
+              2);
+static_assert(INIT_7_LL1.Parse(Tokens(INIT_7, {"a", "b", "a"})).accepted);
+static_assert(!INIT_7_SLR1.Parse(Tokens(INIT_7, {"a", "a", "b"})).accepted);
+static_assert(INIT_8_SLR1.Parse(Tokens(INIT_8, {"b", "a", "a"})).accepted);
+static_assert(INIT_9_LL1.Parse(Tokens(INIT_9, {"b", "b", "a"})).accepted);
+static_assert(!INIT_9_SLR1.Parse(Tokens(INIT_9, {"b"})).accepted);
+
+/**
+ * @brief An expression grammar with one left-recursive operator per
+ * precedence level, A being the lowest: E_i → E_i op_i E_i+1 | E_i+1. The
+ * highest level reads a number or a parenthesised A.
+ */
+Grammar LargeGrammar() {
+    auto level = [](int i) {
+        return i == 0 ? std::string("A") : "E" + std::to_string(i);
+    };
+    std::unordered_map<std::string, std::vector<production>> rules;
+    for (int i = 0; i < PRECEDENCE_LEVELS; ++i) {
+        rules[level(i)] = {{level(i), "op" + std::to_string(i), level(i + 1)},
+                           {level(i + 1)}};
+    }
+    rules[level(PRECEDENCE_LEVELS)] = {{"num"}, {"lpar", "A", "rpar"}};
+    return Grammar(rules);
+}
+
+/// @brief Grammars of a GrammarFactory level, generated as the tutor does
+/// for its LL(1) and SLR(1) exercises.
+std::vector<Grammar> FactoryGrammars(GrammarFactory& factory, int level) {
+    std::vector<Grammar> grammars;
+    for (int i = 0; i < SAMPLES; ++i) {
+        grammars.push_back(factory.GenLL1Grammar(level));
+        grammars.push_back(factory.GenSLR1Grammar(level));
+    }
+    return grammars;
+}
+
+void PrintRow(const std::string& name, std::size_t grammars,
+              std::size_t compared, std::size_t mismatches) {
+    std::cout << "  " << std::left << std::setw(16) << name << std::right
+              << std::setw(10) << grammars << std::setw(12) << compared
+              << std::setw(12) << mismatches << "\n";
+}
+
+void PrintHeader(const std::string& title, const std::string& compared) {
+    std::cout << title << "\n"
+              << "  " << std::left << std::setw(16) << "grammars"
+              << std::right << std::setw(10) << "count" << std::setw(12)
+              << compared << std::setw(12) << "mismatches" << "\n";
+}
+
+/**
+ * @brief Compares every cell of CompressedParseTables with the dense
+ * ACTION and GOTO tables it was built from, for the grammars that are
+ * SLR(1) once augmented.
+ *
+ * @return Whether no cell differs.
+ */
+bool CheckCompressedTables(const std::string&          name,
+                           const std::vector<Grammar>& grammars) {
+    std::size_t cells      = 0;
+    std::size_t mismatches = 0;
+    for (const Grammar& gr : grammars) {
+        Grammar augmented = gr;
+        augmented.TransformToAugmentedGrammar();
+        SLR1Parser parser(augmented);
+        if (!parser.MakeParser()) {
+            continue;
+        }
+        const SymbolTable&    st = parser.gr_.st_;
+        CompressedParseTables tables(parser);
+        for (unsigned int state = 0; state < parser.states_.size(); ++state) {
+            for (SymbolId terminal : st.terminal_ids_) {
+                mismatches += tables.Action(state, terminal) !=
+                              parser.ActionAt(state, terminal);
+            }
+            for (SymbolId non_terminal : st.non_terminal_ids_) {
+                mismatches += tables.Goto(state, non_terminal) !=
+                              parser.GotoAt(state, non_terminal);
+            }
+            cells += st.terminal_ids_.size() + st.non_terminal_ids_.size();
+        }
+    }
+    PrintRow(name, grammars.size(), cells, mismatches);
+    return mismatches == 0;
+}
+
+/**
+ * @brief Calls f with each of SENTENCES random sentences of a grammar and
+ * with each of them with its middle token removed, which is often an error.
+ */
+template <typename F> void ForEachInput(const Grammar& gr, F&& f) {
+    for (std::vector<SymbolId> tokens : Sentences(gr, SENTENCES)) {
+        f(tokens);
+        if (!tokens.empty()) {
+            tokens.erase(tokens.begin() + tokens.size() / 2);
+        }
+        f(tokens);
+    }
+}
+
+/**
+ * @brief Counts the differences between a StaticGrammar with its tables and
+ * the runtime classes built from the same rules: FIRST and FOLLOW of each
+ * non-terminal, whether the grammar is LL(1), the number of LR(0) states,
+ * and the results of parsing random sentences and each of them with its
+ * middle token removed.
+ */
+template <typename StaticGr, typename StaticSLR1>
+std::size_t StaticMismatches(const StaticGr&   static_gr,
+                             const StaticSLR1& static_slr1,
+                             const Rules&      rules) {
+    Grammar            gr(rules);
+    const SymbolTable& st         = gr.st_;
+    std::size_t        mismatches = 0;
+    mismatches += static_gr.terminal_count_ != st.terminal_ids_.size();
+    mismatches += static_gr.non_terminal_count_ != st.non_terminal_ids_.size();
+
+    std::shared_ptr<const GrammarAnalysis> analysis = gr.Analysis();
+    for (std::size_t n = 0; n < static_gr.non_terminal_count_; ++n) {
+        std::uint32_t id = static_gr.non_terminal_ids_[n];
+        SymbolId      nt = st.GetId(std::string(static_gr.names_[id]));
+        for (std::size_t t = 0; t < static_gr.terminal_count_; ++t) {
+            SymbolId terminal = st.GetId(
+                std::string(static_gr.names_[static_gr.terminal_ids_[t]]));
+            std::uint32_t index = st.TerminalIndex(terminal);
+            mismatches += static_gr.first_[id][t] !=
+                          analysis->First(nt).Contains(index);
+            mismatches += static_gr.follow_[id][t] !=
+                          analysis->Follow(nt).Contains(index);
+        }
+    }
+
+    LL1Parser ll1(gr);
+    bool      is_ll1 = ll1.CreateLL1Table();
+    StaticLL1Table static_ll1(static_gr);
+    mismatches += is_ll1 != (static_ll1.conflicts_ == 0);
+    Grammar augmented = gr;
+    augmented.TransformToAugmentedGrammar();
+    SLR1Parser slr1(augmented);
+    slr1.MakeParser();
+    mismatches += slr1.states_.size() != static_slr1.state_count_;
+
+    ForEachInput(gr, [&](const std::vector<SymbolId>& tokens) {
+        std::vector<std::uint32_t> indices;
+        for (SymbolId token : tokens) {
+            indices.push_back(static_gr.FindTerminal(st.Name(token)));
+        }
+        SLR1Parser::ParseResult slr1_result   = slr1.Parse(tokens);
+        StaticParseResult       static_result = static_slr1.Parse(indices);
+        mismatches +=
+            slr1_result.accepted != static_result.accepted ||
+            slr1_result.error_position != static_result.error_position;
+        if (is_ll1) {
+            LL1Parser::ParseResult ll1_result = ll1.Parse(tokens);
+            static_result                     = static_ll1.Parse(indices);
+            mismatches +=
+                ll1_result.accepted != static_result.accepted ||
+                ll1_result.error_position != static_result.error_position;
+        }
+    });
+    return mismatches;
+}
+
+/**
+ * @brief Compares the StaticGrammar versions of the GrammarFactory::Init
+ * grammars with the runtime classes, see StaticMismatches.
+ *
+ * @return Whether no grammar differs.
+ */
+bool CheckStaticGrammars(const GrammarFactory& factory) {
+    const std::vector<GrammarFactory::FactoryItem>& items = factory.items;
+    std::size_t mismatches = items.size() != 9;
+    if (mismatches == 0) {
+        mismatches += StaticMismatches(INIT_1, INIT_1_SLR1, items[0].g_) +
+                      StaticMismatches(INIT_2, INIT_2_SLR1, items[1].g_) +
+                      StaticMismatches(INIT_3, INIT_3_SLR1, items[2].g_) +
+                      StaticMismatches(INIT_4, INIT_4_SLR1, items[3].g_) +
+                      StaticMismatches(INIT_5, INIT_5_SLR1, items[4].g_) +
+                      StaticMismatches(INIT_6, INIT_6_SLR1, items[5].g_) +
+                      StaticMismatches(INIT_7, INIT_7_SLR1, items[6].g_) +
+                      StaticMismatches(INIT_8, INIT_8_SLR1, items[7].g_) +
+                      StaticMismatches(INIT_9, INIT_9_SLR1, items[8].g_);
+    }
+    PrintRow("level 1 items", items.size(), items.size() * SENTENCES * 2,
+             mismatches);
+    return mismatches == 0;
+}
+
+/**
+ * @brief Compares the images of ParserCache with the LL1Parser and
+ * SLR1Parser built from the same grammars: which tables are conflict-free,
+ * the number of states, and the results of parsing, see ForEachInput. The
+ * image compared is the one mapped back from the cache file.
+ *
+ * @return Whether no grammar differs.
+ */
+bool CheckParserImages(const std::string&          name,
+                       const std::vector<Grammar>& grammars,
+                       const ParserCache&          cache) {
+    std::size_t                inputs     = 0;
+    std::size_t                mismatches = 0;
+    std::vector<std::uint32_t> states;
+    std::vector<SymbolId>      symbols;
+    for (const Grammar& gr : grammars) {
+        cache.Load(gr);
+        std::shared_ptr<const ParserImage> image = cache.Load(gr);
+
+        LL1Parser ll1(gr);
+        bool      is_ll1    = ll1.CreateLL1Table();
+        Grammar   augmented = gr;
+        augmented.TransformToAugmentedGrammar();
+        SLR1Parser slr1(augmented);
+        bool       is_slr1 = slr1.MakeParser();
+        mismatches += image->IsLL1() != is_ll1 ||
+                      image->IsSLR1() != is_slr1 ||
+                      image->GetHeader().states != slr1.states_.size();
+
+        ForEachInput(gr, [&](const std::vector<SymbolId>& tokens) {
+            // The image may number the symbols otherwise
+            std::vector<SymbolId> mapped;
+            for (SymbolId token : tokens) {
+                mapped.push_back(image->GetId(gr.st_.Name(token)));
+            }
+            ++inputs;
+            if (is_slr1) {
+                SLR1Parser::ParseResult  expected = slr1.Parse(tokens);
+                ParserImage::ParseResult result =
+                    image->ParseSLR1(mapped, states);
+                mismatches += expected.accepted != result.accepted ||
+                              expected.error_position != result.error_position;
+            }
+            if (is_ll1) {
+                LL1Parser::ParseResult   expected = ll1.Parse(tokens);
+                ParserImage::ParseResult result =
+                    image->ParseLL1(mapped, symbols);
+                mismatches += expected.accepted != result.accepted ||
+                              expected.error_position != result.error_position;
+            }
+        });
+    }
+    PrintRow(name, grammars.size(), inputs, mismatches);
+    return mismatches == 0;
+}
+
+} // namespace
+
+int main() {
+    GrammarFactory factory;
+    factory.Init();
+    std::vector<std::vector<Grammar>> levels;
+    for (int level = 1; level <= FACTORY_LEVELS; ++level) {
+        levels.push_back(FactoryGrammars(factory, level));
+    }
+    bool ok = true;
+
+    PrintHeader("Compressed SLR(1) tables against SLR1Parser", "cells");
+    for (int level = 1; level <= FACTORY_LEVELS; ++level) {
+        ok = CheckCompressedTables("level " + std::to_string(level),
+                                   levels[level - 1]) &&
+             ok;
+    }
+    ok = CheckCompressedTables("large", {LargeGrammar()}) && ok;
+    std::cout << '\n';
+
+    PrintHeader("StaticGrammar tables against the runtime parsers", "inputs");
+    ok = CheckStaticGrammars(factory) && ok;
+    std::cout << '\n';
+
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "syntax_tutor_self_check";
+    std::filesystem::remove_all(directory);
+    ParserCache cache(directory);
+    PrintHeader("Cached parser images against the runtime parsers", "inputs");
+    for (int level = 1; level <= FACTORY_LEVELS; ++level) {
+        ok = CheckParserImages("level " + std::to_string(level),
+                               levels[level - 1], cache) &&
+             ok;
+    }
+    ok = CheckParserImages("large", {LargeGrammar()}, cache) && ok;
+    std::filesystem::remove_all(directory);
+    std::cout << '\n';
+
+    return ok ? 0 : 1;
+}
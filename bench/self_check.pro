@@ -0,0 +1,7 @@
+TEMPLATE = app
+TARGET   = self_check
+
+include(backend.pri)
+
+SOURCES += \
+    self_check.cpp
@@ -476,9 +476,9 @@ void LLTutorWindow::showTable()
                 const QString &cellContent = rawTable[i][j];
 
                 if (!cellContent.isEmpty()) {
-                    QStringList production = stdVectorToQVector(
-                        ll1.gr_.Split(cellContent.toStdString()));
-                    if (production.empty() && !cellContent.isEmpty()) {
+                    Grammar::SplitResult split = ll1.gr_.Split(cellContent.toStdString());
+                    QStringList production = stdVectorToQVector(split.symbols);
+                    if (split.error_position != std::string::npos) {
                         // Split could not process the string
                         production = {cellContent};
                     }
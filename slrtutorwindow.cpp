@@ -583,9 +583,8 @@ void SLRTutorWindow::updateProgressPanel()
 
 void SLRTutorWindow::addUserState(unsigned id)
 {
-    auto st = std::ranges::find_if(slr1.states_, [id](const state &st) { return st.id_ == id; });
-    if (st != slr1.states_.end()) {
-        userMadeStates.insert(*st);
+    if (id < slr1.states_.size()) {
+        userMadeStates.insert(slr1.states_[id]);
         updateProgressPanel();
     }
 }
@@ -926,10 +925,7 @@ QString SLRTutorWindow::generateQuestion()
         currentStateId = statesIdQueue.front();
         statesIdQueue.pop();
 
-        auto currState = std::ranges::find_if(slr1.states_, [&](const state &st) {
-            return st.id_ == currentStateId;
-        });
-        currentSlrState = *currState;
+        currentSlrState = slr1.states_[currentStateId];
 
         return QString("Estado I%1:\n%2\n"
                        "¿Cuántos ítems contiene este estado?")
@@ -1000,10 +996,7 @@ QString SLRTutorWindow::generateQuestion()
     case StateSlr::FA: {
         currentConflictStateId = conflictStatesIdQueue.front();
 
-        auto it = std::ranges::find_if(slr1.states_, [&](const state &st) {
-            return st.id_ == currentConflictStateId;
-        });
-        currentConflictState = *it;
+        currentConflictState = slr1.states_[currentConflictStateId];
 
         return QString("Estado I%1 con conflicto LR(0):\n%2\n"
                        "Indica los símbolos terminales sobre los que debe aplicarse REDUCCIÓN.\n"
@@ -1016,10 +1009,7 @@ QString SLRTutorWindow::generateQuestion()
     case StateSlr::G: {
         currentReduceStateId = reduceStatesIdQueue.front();
 
-        auto it = std::ranges::find_if(slr1.states_, [&](const state &st) {
-            return st.id_ == currentReduceStateId;
-        });
-        currentReduceState = *it;
+        currentReduceState = slr1.states_[currentReduceStateId];
 
         return QString("Estado I%1:\n%2\n"
                        "Indica los terminales sobre los que se aplicará REDUCCIÓN.\n"
@@ -1596,19 +1586,15 @@ bool SLRTutorWindow::verifyResponseForH()
         return false;
     }
 
-    for (const state &slrState : slr1.states_) {
-        unsigned int state = slrState.id_;
-        for (const auto &terminal : slr1.gr_.st_.terminals_) {
-            if (terminal == slr1.gr_.st_.EPSILON_)
+    const SymbolTable &st = slr1.gr_.st_;
+    for (unsigned int state = 0; state < slr1.states_.size(); ++state) {
+        for (SymbolId terminal : st.terminal_ids_) {
+            if (terminal == SymbolTable::EPSILON_ID)
                 continue;
-            QString sym = QString::fromStdString(terminal);
+            QString sym = QString::fromStdString(st.Name(terminal));
 
-            const auto &actMap = slr1.actions_.at(state);
-            auto itAct = actMap.find(terminal);
-            SLR1Parser::s_action expectedAct
-                = (itAct != actMap.end()
-                       ? itAct->second
-                       : SLR1Parser::s_action{nullptr, SLR1Parser::Action::Empty});
+            const SLR1Parser::PackedAction packed = slr1.ActionAt(state, terminal);
+            SLR1Parser::s_action expectedAct = slr1.ActionView(state, terminal);
 
             auto userIt = slrtable[state].find(sym);
             bool userEmpty = (userIt == slrtable[state].end());
@@ -1623,10 +1609,8 @@ bool SLRTutorWindow::verifyResponseForH()
             const ActionEntry &entry = userIt.value();
             switch (expectedAct.action) {
             case SLR1Parser::Action::Shift: {
-                const auto &transMap = slr1.transitions_.at(state);
-                auto itTrans = transMap.find(terminal);
-                if (itTrans == transMap.end() || entry.type != ActionEntry::Shift
-                    || entry.target != static_cast<int>(itTrans->second)) {
+                if (entry.type != ActionEntry::Shift
+                    || entry.target != static_cast<int>(SLR1Parser::ActionTarget(packed))) {
                     return false;
                 }
                 break;
@@ -1659,20 +1643,14 @@ bool SLRTutorWindow::verifyResponseForH()
             }
         }
 
-        for (const auto &nonTerm : slr1.gr_.st_.non_terminals_) {
-            QString sym = QString::fromStdString(nonTerm);
+        for (SymbolId nonTerm : st.non_terminal_ids_) {
+            QString sym = QString::fromStdString(st.Name(nonTerm));
 
             auto userIt = slrtable[state].find(sym);
             bool userEmpty = (userIt == slrtable[state].end());
 
-            if (!slr1.transitions_.contains(state) && userEmpty) {
-                continue;
-            }
-
-            const auto transMap = slr1.transitions_.at(state);
-            auto itTrans = transMap.find(nonTerm);
-            bool hasGoto = (itTrans != transMap.end());
-            unsigned int expectedState = hasGoto ? itTrans->second : 0;
+            unsigned int expectedState = slr1.GotoAt(state, nonTerm);
+            bool hasGoto = (expectedState != SLR1Parser::NO_STATE);
 
             if (!hasGoto && userEmpty) {
                 continue;
@@ -1697,9 +1675,7 @@ bool SLRTutorWindow::verifyResponseForH()
 
 std::unordered_set<Lr0Item> SLRTutorWindow::solutionForA()
 {
-    const auto expected = std::ranges::find_if(slr1.states_,
-                                               [](const state &st) { return st.id_ == 0; });
-    return expected->items_;
+    return slr1.states_[0].items_;
 }
 
 QString SLRTutorWindow::solutionForA1()
@@ -1762,10 +1738,7 @@ QStringList SLRTutorWindow::solutionForCA()
 
 std::unordered_set<Lr0Item> SLRTutorWindow::solutionForCB()
 {
-    auto st = std::ranges::find_if(slr1.states_, [this](const state &st) {
-                  return st.id_ == nextStateId;
-              })->items_;
-    return st;
+    return slr1.states_[nextStateId].items_;
 }
 
 QString SLRTutorWindow::solutionForD()
@@ -1982,8 +1955,7 @@ QString SLRTutorWindow::feedbackForA4()
 
 QString SLRTutorWindow::feedbackForAPrime()
 {
-    const auto &st = std::ranges::find_if(slr1.states_, [](const state &st) { return st.id_ == 0; });
-    QString items = QString::fromStdString(slr1.PrintItems(st->items_));
+    QString items = QString::fromStdString(slr1.PrintItems(slr1.states_[0].items_));
     return QString("El estado inicial (I0) es el cierre del ítem con el axioma. Contiene todos los "
                    "ítems posibles a partir de ese punto.\n%1")
         .arg(items);
@@ -2197,8 +2169,8 @@ std::unordered_set<Lr0Item> SLRTutorWindow::ingestUserItems(const QString &userR
         std::string before_dot = consequent.substr(0, dotpos);
         std::string after_dot = consequent.substr(dotpos + 1);
 
-        std::vector<std::string> splitted_before_dot{grammar.Split(before_dot)};
-        std::vector<std::string> splitted_after_dot{grammar.Split(after_dot)};
+        std::vector<std::string> splitted_before_dot{grammar.Split(before_dot).symbols};
+        std::vector<std::string> splitted_after_dot{grammar.Split(after_dot).symbols};
 
         std::vector<std::string> splitted{splitted_before_dot.begin(), splitted_before_dot.end()};
         splitted.insert(splitted.end(), splitted_after_dot.begin(), splitted_after_dot.end());
@@ -2248,7 +2220,7 @@ std::vector<std::pair<std::string, std::vector<std::string>>> SLRTutorWindow::in
                                         [](char c) { return c == ' ' || c == '\t'; }),
                          consequent.end());
 
-        std::vector<std::string> splitted{grammar.Split(consequent)};
+        std::vector<std::string> splitted{grammar.Split(consequent).symbols};
 
         rules.emplace_back(antecedent, splitted);
     }
@@ -2342,8 +2314,7 @@ void SLRTutorWindow::on_userResponse_textChanged()
 
 void SLRTutorWindow::setupTutorial()
 {
-    userMadeStates.insert(
-        *std::ranges::find_if(slr1.states_, [](const state &st) { return st.id_ == 0; }));
+    userMadeStates.insert(slr1.states_[0]);
     userMadeTransitions[0]["A"] = slr1.transitions_.at(0).at("A");
     updateProgressPanel();
     ui->userResponse->setDisabled(true);